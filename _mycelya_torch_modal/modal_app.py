@@ -14,14 +14,59 @@ Part of: mycelya_torch PyTorch extension
 """
 
 import logging
-from typing import Any, Dict, List, Tuple, Union
+import threading
+import time
+from collections import OrderedDict
+from typing import Any, Dict, List, Optional, Tuple, Union
 
 import modal
 
 log = logging.getLogger(__name__)
 
-# Create simplified image with just PyTorch and CUDA support
-image = modal.Image.debian_slim().pip_install("numpy", "torch")
+# Create simplified image with just PyTorch and CUDA support, plus the
+# transfer compression codecs
+image = modal.Image.debian_slim().pip_install("numpy", "torch", "lz4", "zstandard")
+
+# Content-addressed blob store for upload deduplication. On Modal it lives on a
+# shared volume so blobs survive across sessions; elsewhere (mock execution) it
+# lives on local disk under MYCELYA_BLOB_DIR.
+BLOB_VOLUME_PATH = "/mycelya-blobs"
+DEFAULT_BLOB_DIR = "~/.cache/mycelya_torch/blobs"
+
+# Size the blob store is kept under; least recently used blobs are evicted
+# after each save
+MAX_BLOB_STORE_BYTES = 64 * 1024**3
+
+# Batches accepted concurrently; must be at least the client's largest batch
+# window plus one priority batch, so a batch waiting for its turn never blocks
+# the one it waits for
+MAX_CONCURRENT_BATCHES = 17
+
+# How long a batch waits for an earlier batch of its session that has not
+# arrived (e.g. lost in transit), counted from the session's last progress.
+# The session then fails this and every later batch, and the client continues
+# in a new session.
+BATCH_ORDER_TIMEOUT = 60.0
+
+# Sessions whose batch order and op templates are kept. A client opens one per
+# batching lane and a new one after a lost batch; failed sessions are dropped
+# first, then the least recently used.
+MAX_BATCH_SESSIONS = 8
+
+# Slot marker in op template skeletons; must match mycelya_torch._op_templates
+TEMPLATE_SLOT = "__SLOT__"
+
+
+def _fill_template(skeleton: Any, values: Any) -> Any:
+    """Rebuild call arguments from a template skeleton and its slot values."""
+    kind = type(skeleton)
+    if kind is str and skeleton == TEMPLATE_SLOT:
+        return next(values)
+    if kind in (list, tuple):
+        return kind(_fill_template(item, values) for item in skeleton)
+    if kind is dict:
+        return {key: _fill_template(item, values) for key, item in skeleton.items()}
+    return skeleton
 
 
 def create_modal_app_for_gpu(
@@ -43,16 +88,19 @@ def create_modal_app_for_gpu(
         Tuple of (modal_app, server_class) for the specified device
     """
     app = modal.App(f"mycelya-torch-{machine_id}")
+    blob_volume = modal.Volume.from_name("mycelya-torch-blobs", create_if_missing=True)
 
     @app.cls(
         image=image,
         gpu=gpu_type,
         timeout=timeout,
         retries=retries,
+        volumes={BLOB_VOLUME_PATH: blob_volume},
         serialized=True,
         max_containers=1,
         min_containers=1,
     )
+    @modal.concurrent(max_inputs=MAX_CONCURRENT_BATCHES)
     class PytorchServer:
         def _get_device(self):
             """Get the appropriate device for tensor operations."""
@@ -81,6 +129,92 @@ def create_modal_app_for_gpu(
 
             return self._storages
 
+        def _decode_payload(self, payload: Any) -> Any:
+            """Decompress an upload payload sent as a (codec, data) tuple."""
+            if not isinstance(payload, tuple):
+                return payload
+
+            codec, data = payload
+            if codec == "lz4":
+                import lz4.frame
+
+                return lz4.frame.decompress(data)
+            if codec == "zstd":
+                import zstandard
+
+                return zstandard.ZstdDecompressor().decompress(data)
+            raise ValueError(f"Unknown compression codec {codec!r}")
+
+        def _encode_payload(
+            self, data: bytes, accept_codecs: Optional[List[str]]
+        ) -> Union[bytes, Tuple[str, bytes]]:
+            """
+            Compress a download payload if the client accepts a codec and a
+            sample of the data compresses well. Mirrors the client's selection
+            in mycelya_torch._compression.
+            """
+            if not accept_codecs or len(data) < 64 * 1024:
+                return data
+
+            def _compress(codec: str, buf: Any) -> bytes:
+                if codec == "lz4":
+                    import lz4.frame
+
+                    return lz4.frame.compress(buf)
+                import zstandard
+
+                return zstandard.ZstdCompressor(level=3).compress(buf)
+
+            codec = accept_codecs[0]
+            if len(accept_codecs) > 1:
+                # Sample the first chunk: skip incompressible data, prefer
+                # zstd's ratio when the data is highly compressible
+                sample = memoryview(data)[: 256 * 1024]
+                ratio = len(_compress(codec, sample)) / sample.nbytes
+                if ratio > 0.9:
+                    return data
+                if ratio <= 0.5 and "zstd" in accept_codecs:
+                    codec = "zstd"
+
+            compressed = _compress(codec, data)
+            if len(compressed) >= len(data):
+                return data
+            return (codec, compressed)
+
+        def _private_host_tensor(self, data: Any, storage_tensor: Any) -> Any:
+            """
+            Get data as a flat uint8 CPU tensor that does not alias storage.
+
+            Makes exactly one copy: the D2H transfer on GPU, or a clone when
+            the storage already lives in host memory.
+            """
+            import torch
+
+            host = data.cpu().reshape(-1).view(torch.uint8)
+            aliased = (
+                host.untyped_storage().data_ptr()
+                == storage_tensor.untyped_storage().data_ptr()
+            )
+            if aliased:
+                host = host.clone()
+            return host
+
+        def _realize_storage(self, storage_id: int) -> Any:
+            """Allocate a lazy storage on first write and return its tensor."""
+            import torch
+
+            storages = self._get_storages()
+            storage_item = storages[storage_id]
+            if isinstance(storage_item, int):
+                log.info(
+                    f"📥 LAZY Storage {storage_id} update triggering realization with {storage_item} bytes"
+                )
+                storage_item = torch.empty(
+                    storage_item, dtype=torch.uint8, device=self._get_device()
+                )
+                storages[storage_id] = storage_item
+            return storage_item
+
         def _construct_tensor_from_storage(
             self,
             storage_id: int,
@@ -194,6 +328,8 @@ def create_modal_app_for_gpu(
             target_dtype: str,
         ) -> None:
             """Implementation of update_storage without Modal decorators."""
+            import warnings
+
             import torch
 
             # Get storages
@@ -202,66 +338,28 @@ def create_modal_app_for_gpu(
             if storage_id not in storages:
                 raise RuntimeError(f"Storage ID {storage_id} not found")
 
-            # Deserialize source tensor from raw numpy bytes using provided metadata
+            # Deserialize source tensor from raw bytes using provided metadata
             # Convert dtype string back to torch.dtype
             dtype_name = source_dtype.replace("torch.", "")
             torch_dtype = getattr(torch, dtype_name)
 
-            # Create writable buffer to avoid PyTorch warnings
-            writable_data = bytearray(raw_data)
-
-            # Reconstruct tensor using torch.frombuffer - no clone needed since temp tensor
-            flat_tensor = torch.frombuffer(writable_data, dtype=torch_dtype)
+            # Compressed payloads arrive as a (codec, data) tuple
+            raw_data = self._decode_payload(raw_data)
 
-            # Reshape and apply stride/offset using provided metadata
+            # Wrap the received buffer without copying. The payload is always
+            # packed row-major, so source stride/offset only describe the
+            # caller's original view and are not applied here.
+            if len(raw_data) == 0:
+                flat_tensor = torch.empty(0, dtype=torch_dtype)
+            else:
+                with warnings.catch_warnings():
+                    # Read-only buffers are only read from, never written
+                    warnings.simplefilter("ignore", UserWarning)
+                    flat_tensor = torch.frombuffer(raw_data, dtype=torch_dtype)
             source_tensor = flat_tensor.reshape(source_shape)
 
-            # If the tensor has custom stride or offset, we need to use as_strided
-            if (
-                list(source_tensor.stride()) != source_stride
-                or source_storage_offset != 0
-            ):
-                source_tensor = source_tensor.as_strided(
-                    source_shape, source_stride, source_storage_offset
-                )
-
-            # Ensure tensor is on CPU and has the expected properties
-            if source_tensor.device.type != "cpu":
-                source_tensor = source_tensor.cpu()
-
-            storage_item = storages[storage_id]
-
-            # Check if storage is lazy
-            if isinstance(storage_item, int):
-                # Move source tensor to appropriate device for storage
-                device = self._get_device()
-                device_source = source_tensor.to(device)
-                expected_bytes = storage_item
-                # Extract storage once but keep device_source alive
-                device_source_storage = device_source.untyped_storage()
-                actual_bytes = device_source_storage.nbytes()
-
-                if expected_bytes != actual_bytes:
-                    raise RuntimeError(
-                        f"Storage size mismatch for storage {storage_id}: "
-                        f"expected {expected_bytes} bytes, got {actual_bytes} bytes"
-                    )
-
-                log.info(
-                    f"📥 LAZY Storage {storage_id} update triggering realization with {expected_bytes} bytes"
-                )
-                # Create 1D uint8 tensor from the device source tensor's storage
-                storage_tensor = torch.empty(
-                    actual_bytes, dtype=torch.uint8, device=device
-                )
-                storage_tensor.untyped_storage().copy_(device_source_storage)
-                # Ensure device_source stays alive until after copy operation
-                del device_source_storage  # Release reference after use
-                storages[storage_id] = storage_tensor
-                log.info(
-                    f"📥 LAZY Updated Storage ID {storage_id} on Modal (realized: shape: {source_tensor.shape})"
-                )
-                return
+            # Realize lazy storage, then write through the target view below
+            self._realize_storage(storage_id)
 
             # Storage is realized (torch.Tensor) - always use in-place view update
             log.info(
@@ -277,8 +375,9 @@ def create_modal_app_for_gpu(
                 dtype=target_dtype,
             )
 
-            # Copy source tensor data to target view in-place
-            target_tensor.copy_(source_tensor.to(target_tensor.device))
+            # Copy source tensor data to target view in-place; copy_ moves the
+            # host data to the device without an intermediate tensor
+            target_tensor.copy_(source_tensor)
 
             log.info(
                 f"📥 IN-PLACE Updated view of Storage ID {storage_id} on Modal (target_shape: {target_shape})"
@@ -306,7 +405,7 @@ def create_modal_app_for_gpu(
 
             Args:
                 storage_id: Storage ID to update
-                raw_data: Raw untyped storage bytes to store
+                raw_data: Source view bytes packed row-major (bytes or any buffer)
                 source_shape: Shape of the source data
                 source_stride: Stride of the source data
                 source_storage_offset: Storage offset of the source data
@@ -335,8 +434,16 @@ def create_modal_app_for_gpu(
         def _get_storage_data_impl(
             self,
             storage_id: int,
-        ) -> bytes:
+            shape: Optional[List[int]] = None,
+            stride: Optional[List[int]] = None,
+            storage_offset: int = 0,
+            dtype: Optional[str] = None,
+            accept_codecs: Optional[List[str]] = None,
+            as_tensor: bool = False,
+        ) -> Union[bytes, Tuple[str, bytes], Any]:
             """Implementation of get_storage_data without Modal decorators."""
+            import torch
+
             # Get storages
             storages = self._get_storages()
 
@@ -351,36 +458,412 @@ def create_modal_app_for_gpu(
                     f"Storage ID {storage_id} is lazy (not realized). Cannot retrieve data."
                 )
 
-            # Storage is realized (torch.Tensor)
-            storage_tensor = storage_item
+            if shape is None:
+                # Whole storage (already a 1D uint8 tensor)
+                data_tensor = storage_item
+            else:
+                # Gather exactly the requested view on device before transfer
+                data_tensor = self._construct_tensor_from_storage(
+                    storage_id=storage_id,
+                    shape=shape,
+                    stride=stride,
+                    storage_offset=storage_offset,
+                    dtype=dtype,
+                ).contiguous()
+
             log.info(
-                f"📦 Retrieving tensor data for storage {storage_id} ({storage_tensor.untyped_storage().nbytes()} bytes)"
+                f"📦 Retrieving tensor data for storage {storage_id} ({data_tensor.numel() * data_tensor.element_size()} bytes)"
             )
 
-            # Convert CUDA tensor to CPU and serialize with pure numpy approach
-            cpu_tensor = storage_tensor.cpu()
+            if as_tensor:
+                return self._private_host_tensor(data_tensor, storage_item)
 
-            # Return raw numpy bytes directly - no metadata needed since it's handled separately
-            return cpu_tensor.numpy().tobytes()
+            # Serialize as raw bytes; the uint8 view also covers dtypes numpy
+            # does not support (e.g. bfloat16)
+            cpu_tensor = data_tensor.cpu().reshape(-1).view(torch.uint8)
+            return self._encode_payload(cpu_tensor.numpy().tobytes(), accept_codecs)
 
         @modal.method()
         def get_storage_data(
             self,
             storage_id: int,
-        ) -> bytes:
+            shape: Optional[List[int]] = None,
+            stride: Optional[List[int]] = None,
+            storage_offset: int = 0,
+            dtype: Optional[str] = None,
+            accept_codecs: Optional[List[str]] = None,
+            as_tensor: bool = False,
+        ) -> Union[bytes, Tuple[str, bytes], Any]:
             """
             Retrieve raw storage data by storage ID.
 
-            Returns the complete raw untyped storage bytes. The client interface layer
-            will handle tensor reconstruction from metadata and these raw bytes.
+            Returns the complete raw untyped storage bytes, or when view
+            parameters are given only the elements of that view packed
+            row-major. The client interface layer handles tensor
+            reconstruction from metadata and these raw bytes.
 
             Args:
                 storage_id: The storage ID
+                shape: Shape of the view to gather, or None for the whole storage
+                stride: Stride of the view to gather
+                storage_offset: Storage offset of the view to gather
+                dtype: Data type of the view to gather
+                accept_codecs: Codecs the client can decode, in order of preference
+                as_tensor: Return a private uint8 CPU tensor instead of bytes,
+                    for in-process callers
+
+            Returns:
+                Raw bytes of the storage or of the gathered view, or a
+                (codec, compressed bytes) tuple if compression paid off
+            """
+            return self._get_storage_data_impl(
+                storage_id,
+                shape,
+                stride,
+                storage_offset,
+                dtype,
+                accept_codecs,
+                as_tensor,
+            )
+
+        def _write_storage_bytes_impl(
+            self, storage_id: int, byte_offset: int, raw_data: Any
+        ) -> None:
+            """Implementation of write_storage_bytes without Modal decorators."""
+            import warnings
+
+            import torch
+
+            storages = self._get_storages()
+            if storage_id not in storages:
+                raise RuntimeError(f"Storage ID {storage_id} not found")
+
+            raw_data = self._decode_payload(raw_data)
+            nbytes = len(raw_data)
+            if nbytes == 0:
+                return
+
+            storage_tensor = self._realize_storage(storage_id)
+            if byte_offset + nbytes > storage_tensor.numel():
+                raise RuntimeError(
+                    f"Chunk [{byte_offset}, {byte_offset + nbytes}) is out of bounds "
+                    f"for storage {storage_id} ({storage_tensor.numel()} bytes)"
+                )
+
+            with warnings.catch_warnings():
+                # Read-only buffers are only read from, never written
+                warnings.simplefilter("ignore", UserWarning)
+                chunk = torch.frombuffer(raw_data, dtype=torch.uint8)
+
+            # H2D copy straight into the destination byte range
+            storage_tensor[byte_offset : byte_offset + nbytes].copy_(chunk)
+
+        @modal.method()
+        def write_storage_bytes(
+            self, storage_id: int, byte_offset: int, raw_data: Any
+        ) -> None:
+            """
+            Write one chunk of a streamed upload into a storage byte range.
+
+            Args:
+                storage_id: Storage ID to write into
+                byte_offset: Byte offset of the chunk within the storage
+                raw_data: Chunk bytes, or a (codec, compressed bytes) tuple
+
+            Returns:
+                None
+            """
+            return self._write_storage_bytes_impl(storage_id, byte_offset, raw_data)
+
+        def _write_storages_packed_impl(
+            self, entries: List[Tuple[int, int, int, int]], raw_data: Any
+        ) -> None:
+            """Implementation of write_storages_packed without Modal decorators."""
+            import warnings
+
+            import torch
+
+            storages = self._get_storages()
+            for storage_id, _, _, _ in entries:
+                if storage_id not in storages:
+                    raise RuntimeError(f"Storage ID {storage_id} not found")
+
+            raw_data = self._decode_payload(raw_data)
+            with warnings.catch_warnings():
+                # Read-only buffers are only read from, never written
+                warnings.simplefilter("ignore", UserWarning)
+                packed = torch.frombuffer(raw_data, dtype=torch.uint8)
+
+            # One H2D copy for the whole payload, then device-side scatter
+            packed = packed.to(self._get_device())
+            for storage_id, byte_offset, payload_offset, nbytes in entries:
+                storage_tensor = self._realize_storage(storage_id)
+                if byte_offset + nbytes > storage_tensor.numel():
+                    raise RuntimeError(
+                        f"Range [{byte_offset}, {byte_offset + nbytes}) is out of "
+                        f"bounds for storage {storage_id} ({storage_tensor.numel()} bytes)"
+                    )
+                storage_tensor[byte_offset : byte_offset + nbytes].copy_(
+                    packed[payload_offset : payload_offset + nbytes]
+                )
+
+            log.info(f"📥 Scattered packed upload into {len(entries)} storages")
+
+        @modal.method()
+        def write_storages_packed(
+            self, entries: List[Tuple[int, int, int, int]], raw_data: Any
+        ) -> None:
+            """
+            Scatter a packed multi-tensor upload into storage byte ranges.
+
+            Args:
+                entries: (storage_id, byte_offset, payload_offset, nbytes) for
+                    each tensor packed into raw_data
+                raw_data: Packed bytes, or a (codec, compressed bytes) tuple
+
+            Returns:
+                None
+            """
+            return self._write_storages_packed_impl(entries, raw_data)
+
+        def _read_storage_bytes_impl(
+            self,
+            storage_id: int,
+            byte_offset: int,
+            nbytes: int,
+            accept_codecs: Optional[List[str]] = None,
+            as_tensor: bool = False,
+        ) -> Union[bytes, Tuple[str, bytes], Any]:
+            """Implementation of read_storage_bytes without Modal decorators."""
+            storages = self._get_storages()
+            if storage_id not in storages:
+                raise RuntimeError(f"Storage ID {storage_id} not found")
+
+            storage_item = storages[storage_id]
+            if isinstance(storage_item, int):
+                raise RuntimeError(
+                    f"Storage ID {storage_id} is lazy (not realized). Cannot retrieve data."
+                )
+
+            chunk = storage_item[byte_offset : byte_offset + nbytes]
+            if as_tensor:
+                return self._private_host_tensor(chunk, storage_item)
+
+            # D2H copy of just this byte range
+            return self._encode_payload(chunk.cpu().numpy().tobytes(), accept_codecs)
+
+        @modal.method()
+        def read_storage_bytes(
+            self,
+            storage_id: int,
+            byte_offset: int,
+            nbytes: int,
+            accept_codecs: Optional[List[str]] = None,
+            as_tensor: bool = False,
+        ) -> Union[bytes, Tuple[str, bytes], Any]:
+            """
+            Read one chunk of a streamed download from a storage byte range.
+
+            Args:
+                storage_id: Storage ID to read from
+                byte_offset: Byte offset of the chunk within the storage
+                nbytes: Number of bytes to read
+                accept_codecs: Codecs the client can decode, in order of preference
+                as_tensor: Return a private uint8 CPU tensor instead of bytes,
+                    for in-process callers
+
+            Returns:
+                Chunk bytes, or a (codec, compressed bytes) tuple
+            """
+            return self._read_storage_bytes_impl(
+                storage_id, byte_offset, nbytes, accept_codecs, as_tensor
+            )
+
+        def _blob_path(self, digest: str) -> str:
+            """Get the on-disk path of a content-addressed blob."""
+            import os
+
+            blob_dir = os.environ.get("MYCELYA_BLOB_DIR")
+            if blob_dir is None:
+                if os.path.isdir(BLOB_VOLUME_PATH):
+                    blob_dir = BLOB_VOLUME_PATH
+                else:
+                    blob_dir = os.path.expanduser(DEFAULT_BLOB_DIR)
+            return os.path.join(blob_dir, digest[:2], digest)
+
+        def _write_storage_from_blob_impl(
+            self, storage_id: int, byte_offset: int, digest: str, nbytes: int
+        ) -> bool:
+            """Implementation of write_storage_from_blob without Modal decorators."""
+            import os
+
+            import torch
+
+            storages = self._get_storages()
+            if storage_id not in storages:
+                raise RuntimeError(f"Storage ID {storage_id} not found")
+
+            # A save of the same blob may still be being written
+            self._get_blob_writer()
+            pending = self._pending_blobs.get(digest)
+            if pending is not None:
+                pending.result()
+
+            path = self._blob_path(digest)
+            if not os.path.isfile(path) or os.path.getsize(path) != nbytes:
+                log.info(f"📦 Blob {digest[:12]} not in store ({nbytes} bytes)")
+                return False
+
+            storage_tensor = self._realize_storage(storage_id)
+            if byte_offset + nbytes > storage_tensor.numel():
+                raise RuntimeError(
+                    f"Blob [{byte_offset}, {byte_offset + nbytes}) is out of bounds "
+                    f"for storage {storage_id} ({storage_tensor.numel()} bytes)"
+                )
+
+            # Memory-map the blob and copy it straight into the byte range
+            blob = torch.from_file(path, shared=False, size=nbytes, dtype=torch.uint8)
+            storage_tensor[byte_offset : byte_offset + nbytes].copy_(blob)
+            # Mark it recently used so eviction keeps it
+            os.utime(path)
+            log.info(f"📦 Storage {storage_id} filled from blob {digest[:12]}")
+            return True
+
+        @modal.method()
+        def write_storage_from_blob(
+            self, storage_id: int, byte_offset: int, digest: str, nbytes: int
+        ) -> bool:
+            """
+            Fill a storage byte range from the content-addressed blob store.
+
+            Args:
+                storage_id: Storage ID to write into
+                byte_offset: Byte offset of the range within the storage
+                digest: Content hash of the bytes
+                nbytes: Number of bytes in the range
+
+            Returns:
+                True if the blob was found and copied, False if it must be uploaded
+            """
+            return self._write_storage_from_blob_impl(
+                storage_id, byte_offset, digest, nbytes
+            )
+
+        def _get_blob_writer(self):
+            """Get the single-threaded executor that writes blobs to the store."""
+            if not hasattr(self, "_blob_writer"):
+                from concurrent.futures import ThreadPoolExecutor
+
+                self._blob_writer = ThreadPoolExecutor(
+                    max_workers=1, thread_name_prefix="mycelya-blobs"
+                )
+                # Digests queued for writing -> their write, so repeated saves
+                # are skipped and lookups can wait for them
+                self._pending_blobs: Dict[str, Any] = {}
+            return self._blob_writer
+
+        def _save_storage_blob_impl(
+            self, storage_id: int, byte_offset: int, nbytes: int, digest: str
+        ) -> None:
+            """Implementation of save_storage_blob without Modal decorators."""
+            import os
+
+            storages = self._get_storages()
+            if storage_id not in storages:
+                raise RuntimeError(f"Storage ID {storage_id} not found")
+
+            writer = self._get_blob_writer()
+            path = self._blob_path(digest)
+            if digest in self._pending_blobs or os.path.isfile(path):
+                return
+
+            storage_item = storages[storage_id]
+            if isinstance(storage_item, int):
+                raise RuntimeError(
+                    f"Storage ID {storage_id} is lazy (not realized). Cannot save blob."
+                )
+
+            # Snapshot the range before later calls can overwrite it; the disk
+            # write and volume commit happen off the execution path
+            data = storage_item[byte_offset : byte_offset + nbytes].to(
+                "cpu", copy=True
+            )
+            self._pending_blobs[digest] = writer.submit(
+                self._write_blob, path, data, digest
+            )
+
+        def _write_blob(self, path: str, data: Any, digest: str) -> None:
+            """Write a snapshotted blob to the store and evict old blobs."""
+            import os
+            import tempfile
+
+            try:
+                # Write to a temporary file and rename so concurrent readers
+                # never see a partial blob
+                os.makedirs(os.path.dirname(path), exist_ok=True)
+                fd, tmp_path = tempfile.mkstemp(dir=os.path.dirname(path))
+                try:
+                    with os.fdopen(fd, "wb") as f:
+                        f.write(memoryview(data.numpy()))
+                    os.replace(tmp_path, path)
+                except Exception:
+                    os.unlink(tmp_path)
+                    raise
+
+                self._evict_blobs(os.path.dirname(os.path.dirname(path)))
+                if path.startswith(BLOB_VOLUME_PATH):
+                    blob_volume.commit()
+                log.info(f"📦 Saved blob {digest[:12]} ({data.numel()} bytes)")
+            except Exception as e:
+                log.warning(f"⚠️ Failed to save blob {digest[:12]}: {e}")
+            finally:
+                self._pending_blobs.pop(digest, None)
+
+        def _evict_blobs(self, blob_dir: str) -> None:
+            """Delete least recently used blobs until the store fits its budget."""
+            import os
+
+            blobs = []
+            total = 0
+            for entry in os.scandir(blob_dir):
+                if not entry.is_dir():
+                    continue
+                for blob in os.scandir(entry.path):
+                    if blob.is_file():
+                        stat = blob.stat()
+                        blobs.append((stat.st_mtime, stat.st_size, blob.path))
+                        total += stat.st_size
+
+            blobs.sort()
+            for _, size, blob_path in blobs:
+                if total <= MAX_BLOB_STORE_BYTES:
+                    break
+                try:
+                    os.unlink(blob_path)
+                except FileNotFoundError:
+                    pass
+                total -= size
+                log.info(f"📦 Evicted blob {os.path.basename(blob_path)[:12]}")
+
+        @modal.method()
+        def save_storage_blob(
+            self, storage_id: int, byte_offset: int, nbytes: int, digest: str
+        ) -> None:
+            """
+            Save a storage byte range to the content-addressed blob store.
+
+            The range is snapshotted right away and written in the background.
+
+            Args:
+                storage_id: Storage ID to read from
+                byte_offset: Byte offset of the range within the storage
+                nbytes: Number of bytes in the range
+                digest: Content hash of the bytes, computed by the client
 
             Returns:
-                Raw untyped storage bytes
+                None
             """
-            return self._get_storage_data_impl(storage_id)
+            return self._save_storage_blob_impl(storage_id, byte_offset, nbytes, digest)
 
         def _resize_storage_impl(self, storage_id: int, nbytes: int) -> None:
             """Implementation of resize_storage without Modal decorators."""
@@ -477,6 +960,34 @@ def create_modal_app_for_gpu(
             """
             return self._remove_storage_impl(storage_id)
 
+        def _apply_rng_state(self, rng_state: Dict[str, int]) -> None:
+            """
+            Position the device generator at the client-reserved Philox range.
+
+            The client owns the generator state and reserves a disjoint counter
+            range for every random op, so results only depend on (seed, offset)
+            and not on batching or server-side history.
+
+            Args:
+                rng_state: Dict with "seed" and "offset" reserved by the client
+            """
+            import torch
+
+            seed = rng_state["seed"]
+            offset = rng_state["offset"]
+            device = self._get_device()
+
+            if device.type == "cuda":
+                generator = torch.cuda.default_generators[torch.cuda.current_device()]
+                generator.manual_seed(seed)
+                generator.set_offset(offset)
+            else:
+                # CPU generators are not counter-based; derive a distinct seed
+                # for each reserved range instead
+                torch.default_generator.manual_seed(
+                    (seed + offset * 0x9E3779B97F4A7C15) % (1 << 64)
+                )
+
         def _execute_aten_operation_impl(
             self,
             op_name: str,
@@ -485,6 +996,7 @@ def create_modal_app_for_gpu(
             args: List[Any],
             kwargs: Dict[str, Any],
             return_metadata: bool = False,
+            rng_state: Optional[Dict[str, int]] = None,
         ) -> Union[None, List[Dict[str, Any]]]:
             """Implementation of execute_aten_operation without Modal decorators."""
             # Import torch and tree_map locally to avoid serialization issues
@@ -546,6 +1058,10 @@ def create_modal_app_for_gpu(
                 f"{len(input_tensors)} inputs, {len([s for s in output_storage_ids if s is not None])} outputs to update"
             )
 
+            # Random ops draw from the Philox range reserved by the client
+            if rng_state is not None:
+                self._apply_rng_state(rng_state)
+
             # Execute the operation on input tensors - this will create result tensors
             result = op(*processed_args, **processed_kwargs)
 
@@ -608,6 +1124,7 @@ def create_modal_app_for_gpu(
             args: List[Any],
             kwargs: Dict[str, Any],
             return_metadata: bool = False,
+            rng_state: Optional[Dict[str, int]] = None,
         ) -> Union[None, List[Dict[str, Any]]]:
             """
             Execute an operation with separated input metadata and output storage IDs.
@@ -622,6 +1139,7 @@ def create_modal_app_for_gpu(
                 args: Operation arguments (with tensor placeholders)
                 kwargs: Operation keyword arguments (with tensor placeholders)
                 return_metadata: If True, return output tensor metadata instead of None
+                rng_state: Philox seed/offset reserved by the client for random operations
 
             Returns:
                 None for normal operations, or List[Dict] of output tensor metadata if return_metadata=True
@@ -633,11 +1151,92 @@ def create_modal_app_for_gpu(
                 args,
                 kwargs,
                 return_metadata,
+                rng_state,
             )
 
+        def _wait_for_batch_turn(self, order: Tuple[str, int]) -> Dict[str, Any]:
+            """
+            Block until every earlier batch of the session has executed.
+
+            Sessions are ordered independently of each other, so a client's
+            priority lane never waits for bulk batches still in transit.
+
+            Returns:
+                The session's state: next sequence number and op templates
+
+            Raises:
+                RuntimeError: If an earlier batch did not arrive in time; the
+                    session is failed so no batch of it runs out of order
+            """
+            session, seq = order
+            # setdefault is atomic, so concurrent first batches share one
+            cond = self.__dict__.setdefault("_batch_cond", threading.Condition())
+            with cond:
+                sessions = self.__dict__.setdefault("_batch_sessions", OrderedDict())
+                state = sessions.get(session)
+                if state is None:
+                    # First batch of a new client session to arrive; later
+                    # ones may overtake seq 0 in transit
+                    state = {"next_seq": 0, "templates": {}, "arrived": set()}
+                    sessions[session] = state
+                    self._evict_batch_sessions(sessions)
+                sessions.move_to_end(session)
+                state["arrived"].add(seq)
+
+                # The timeout only covers a predecessor that never arrived: it
+                # restarts whenever the session advances, and a predecessor
+                # still executing or waiting for the lock is waited for
+                waiting_for = state["next_seq"]
+                deadline = time.monotonic() + BATCH_ORDER_TIMEOUT
+                while True:
+                    if state.get("failed"):
+                        state["arrived"].discard(seq)
+                        raise RuntimeError(
+                            f"Batch {seq} of session {session} dropped: an "
+                            f"earlier batch of the session never arrived"
+                        )
+                    if state["next_seq"] >= seq:
+                        return state
+                    now = time.monotonic()
+                    if state["next_seq"] != waiting_for:
+                        waiting_for = state["next_seq"]
+                        deadline = now + BATCH_ORDER_TIMEOUT
+                    elif now >= deadline:
+                        if waiting_for in state["arrived"]:
+                            deadline = now + BATCH_ORDER_TIMEOUT
+                            continue
+                        log.error(
+                            f"❌ Batch {waiting_for} of session {session} never "
+                            f"arrived, failing the session"
+                        )
+                        state["failed"] = True
+                        cond.notify_all()
+                        continue
+                    cond.wait(deadline - now)
+
+        def _evict_batch_sessions(self, sessions: Any) -> None:
+            """Drop failed sessions first, then the least recently used ones."""
+            failed = [key for key, state in sessions.items() if state.get("failed")]
+            while len(sessions) > MAX_BATCH_SESSIONS:
+                # The newest session is last and never a candidate
+                sessions.pop(failed.pop(0) if failed else next(iter(sessions)))
+
+        def _finish_batch_turn(self, order: Tuple[str, int]) -> None:
+            """Let the next batch of the session run."""
+            session, seq = order
+            cond = self._batch_cond
+            with cond:
+                state = self._batch_sessions.get(session)
+                if state is not None:
+                    state["next_seq"] = max(state["next_seq"], seq + 1)
+                    state["arrived"].discard(seq)
+                cond.notify_all()
+
         @modal.method()
         def execute_batch(
-            self, batch_calls: List[Dict[str, Any]]
+            self,
+            batch_calls: List[Dict[str, Any]],
+            order: Optional[Tuple[str, int]] = None,
         ) -> List[Union[None, Any]]:
             """
             Execute a batch of RPCs in sequence.
@@ -651,13 +1250,63 @@ def create_modal_app_for_gpu(
                     - call_type: "spawn" or "remote"
                     - args: Arguments for the method
                     - kwargs: Keyword arguments for the method
-                    - call_id: Unique identifier for debugging
+                    - call_id: Unique identifier for debugging (optional)
+                    - template: Op template ID; args then holds only the
+                      template's slot values (optional)
+                    - template_def: Skeleton defining that template on first
+                      use (optional)
+                order: (session, sequence number) of a pipelined batch. Batches
+                    of a session arrive concurrently and run strictly in
+                    sequence order; None runs the batch on arrival.
 
             Returns:
                 List of results in the same order as input calls.
                 None for "spawn" calls, actual return value for "remote" calls.
             """
+            # Batches of different sessions may be due at once; they still
+            # execute one at a time
+            lock = self.__dict__.setdefault("_execute_lock", threading.Lock())
+            if order is None:
+                with lock:
+                    return self._execute_batch_calls(batch_calls)
+
+            state = self._wait_for_batch_turn(order)
+            try:
+                with lock:
+                    return self._execute_batch_calls(batch_calls, state["templates"])
+            finally:
+                self._finish_batch_turn(order)
+
+        def _expand_template(
+            self, call: Dict[str, Any], templates: Dict[int, Any]
+        ) -> tuple:
+            """
+            Rebuild the arguments of a call sent as an op template reference.
+
+            Args:
+                call: Batched call with "template", slot values in "args" and,
+                    on first use, the skeleton in "template_def"
+                templates: Op template table of the batch's session
+
+            Returns:
+                Full argument tuple for the call's method
 
+            Raises:
+                KeyError: If the template was never defined in this session
+            """
+            template_id = call["template"]
+            if "template_def" in call:
+                templates[template_id] = call["template_def"]
+            if template_id not in templates:
+                raise KeyError(f"Unknown op template {template_id}")
+            return _fill_template(templates[template_id], iter(call["args"]))
+
+        def _execute_batch_calls(
+            self,
+            batch_calls: List[Dict[str, Any]],
+            templates: Optional[Dict[int, Any]] = None,
+        ) -> List[Union[None, Any]]:
+            """Execute the calls of one batch in order, collecting results."""
             log.info(f"🚀 BATCH EXECUTE: Processing {len(batch_calls)} batched RPCs")
             results = []
 
@@ -673,6 +1322,11 @@ def create_modal_app_for_gpu(
                         f"📞 Executing batched RPC {call_id}: {method_name} ({call_type})"
                     )
 
+                    if "template" in call:
+                        args = self._expand_template(
+                            call, {} if templates is None else templates
+                        )
+
                     # Call the underlying method implementations directly
                     # We need to bypass Modal decorators and call the actual Python methods
                     if method_name == "create_storage":
@@ -681,6 +1335,16 @@ def create_modal_app_for_gpu(
                         result = self._update_storage_impl(*args, **kwargs)
                     elif method_name == "get_storage_data":
                         result = self._get_storage_data_impl(*args, **kwargs)
+                    elif method_name == "write_storage_bytes":
+                        result = self._write_storage_bytes_impl(*args, **kwargs)
+                    elif method_name == "write_storages_packed":
+                        result = self._write_storages_packed_impl(*args, **kwargs)
+                    elif method_name == "read_storage_bytes":
+                        result = self._read_storage_bytes_impl(*args, **kwargs)
+                    elif method_name == "write_storage_from_blob":
+                        result = self._write_storage_from_blob_impl(*args, **kwargs)
+                    elif method_name == "save_storage_blob":
+                        result = self._save_storage_blob_impl(*args, **kwargs)
                     elif method_name == "resize_storage":
                         result = self._resize_storage_impl(*args, **kwargs)
                     elif method_name == "remove_storage":
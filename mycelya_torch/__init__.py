@@ -1,7 +1,9 @@
 # Copyright (C) 2025 alyxya
 # SPDX-License-Identifier: AGPL-3.0-or-later
 
+import asyncio
 import types
+from concurrent.futures import Future
 from typing import Any, Callable, Dict, Optional, Union
 
 import torch
@@ -58,6 +60,218 @@ def _create_module() -> types.ModuleType:
         """
         return driver.device_count()
 
+    def current_device() -> int:
+        """Get the index of the current remote device.
+
+        Returns:
+            Index of the current remote device
+        """
+        return driver.exec("get_device")
+
+    def set_device(device: Union[int, torch.device]) -> None:
+        """Set the current remote device.
+
+        Used by DataLoader's pin-memory thread when pin_memory_device="mycelya".
+
+        Args:
+            device: Remote device index or torch.device to make current
+        """
+        idx = device.index if isinstance(device, torch.device) else device
+        if idx is not None:
+            driver.exec("set_device", idx)
+
+    def host_memory_stats() -> Dict[str, Any]:
+        """Get statistics for the pinned host staging pool.
+
+        Returns:
+            Dict with allocated, cached and reserved bytes and pool hit counts
+        """
+        return mycelya_torch._C._pinned_memory_stats()
+
+    def empty_host_cache() -> None:
+        """Release cached pinned host buffers back to the operating system."""
+        mycelya_torch._C._pinned_memory_empty_cache()
+
+    def set_transfer_compression(mode: str) -> None:
+        """Set the compression mode for storage uploads and downloads.
+
+        Args:
+            mode: "off", "auto" (sample each payload and pick LZ4 or zstd),
+                "lz4" or "zstd"
+        """
+        from ._compression import set_transfer_compression as _set_mode
+
+        _set_mode(mode)
+
+    def wire_dtype(dtype: Optional[torch.dtype]):
+        """Context manager transferring floating point data as a narrower dtype.
+
+        Applies to CPU↔remote copies made inside the block; data is restored
+        to the destination dtype on arrival. Takes precedence over per-tensor
+        policies set with set_wire_dtype().
+
+        Args:
+            dtype: torch.float16, torch.bfloat16, an fp8 dtype, or None for
+                full precision
+        """
+        from ._wire_dtype import wire_dtype as _wire_dtype
+
+        return _wire_dtype(dtype)
+
+    def set_wire_dtype(tensor: torch.Tensor, dtype: Optional[torch.dtype]) -> None:
+        """Transfer a remote tensor's storage as a narrower dtype.
+
+        Applies to every upload into and download from the tensor's storage
+        until cleared with None or the storage is freed.
+
+        Args:
+            tensor: Remote tensor
+            dtype: torch.float16, torch.bfloat16, an fp8 dtype, or None to clear
+        """
+        from ._wire_dtype import set_wire_dtype as _set_wire_dtype
+
+        _set_wire_dtype(tensor, dtype)
+
+    def transfer_stats() -> Dict[str, Any]:
+        """Get storage transfer statistics for every remote machine.
+
+        Returns:
+            Dict mapping machine ID to raw and on-the-wire bytes, achieved
+            compression ratio per direction, and codec usage counts
+        """
+        from .device import get_all_machines
+
+        return {
+            machine.machine_id: machine._client.get_transfer_stats()
+            for machine in get_all_machines()
+            if machine._client is not None
+        }
+
+    def storage_cache_stats() -> Dict[str, Any]:
+        """Get download cache statistics for every remote machine.
+
+        Returns:
+            Dict mapping machine ID to cached storages and bytes, the byte
+            budget, hits, misses, evictions and hit counts per cached storage
+        """
+        from .device import get_all_machines
+
+        return {
+            machine.machine_id: machine._client.get_cache_stats()
+            for machine in get_all_machines()
+            if machine._client is not None
+        }
+
+    def batch_stats() -> Dict[str, Any]:
+        """Get RPC batching statistics for every remote machine.
+
+        Returns:
+            Dict mapping machine ID to pending calls and bytes, queue limits
+            and producer stall time, flush policy and pipeline statistics
+        """
+        from .device import get_all_machines
+
+        return {
+            machine.machine_id: machine._client.get_batch_stats()
+            for machine in get_all_machines()
+            if machine._client is not None
+        }
+
+    def set_storage_cache_limits(
+        max_bytes: int, max_entry_bytes: Optional[int] = None
+    ) -> None:
+        """Bound the download cache of every remote machine.
+
+        Least recently used storages are evicted to stay within max_bytes.
+
+        Args:
+            max_bytes: Bytes of downloaded storages kept per machine (0
+                disables caching)
+            max_entry_bytes: Storages larger than this are never cached, or
+                None for no per-storage limit
+        """
+        from .device import get_all_machines
+
+        for machine in get_all_machines():
+            if machine._client is not None:
+                machine._client.set_cache_limits(max_bytes, max_entry_bytes)
+
+    def synchronize(device: Optional[Union[int, torch.device]] = None) -> None:
+        """Wait for all non_blocking copies to or from a remote device.
+
+        Args:
+            device: Remote device index or torch.device, or None for all devices
+        """
+        from ._remote_orchestrator import remote_orchestrator
+
+        idx = device.index if isinstance(device, torch.device) else device
+        remote_orchestrator.synchronize(idx)
+
+    def cpu_async(tensor: torch.Tensor) -> Future:
+        """Copy a remote tensor to the CPU without waiting.
+
+        The download is queued behind every operation already queued for the
+        tensor's device, so results of several steps can be requested before
+        waiting on any of them. synchronize() also waits for it.
+
+        Args:
+            tensor: Remote tensor
+
+        Returns:
+            concurrent.futures.Future resolving to a CPU copy of the tensor
+        """
+        from ._aten_impl import download_async
+
+        return download_async(tensor)
+
+    def item_async(tensor: torch.Tensor) -> Future:
+        """Get the value of a one-element remote tensor without waiting.
+
+        Args:
+            tensor: Remote tensor with exactly one element
+
+        Returns:
+            concurrent.futures.Future resolving to a Python number
+        """
+        if tensor.numel() != 1:
+            raise RuntimeError(
+                f"a Tensor with {tensor.numel()} elements cannot be converted "
+                "to Scalar"
+            )
+
+        result = Future()
+
+        def _on_tensor(done: Future) -> None:
+            try:
+                result.set_result(done.result().item())
+            except Exception as e:
+                result.set_exception(e)
+
+        cpu_async(tensor).add_done_callback(_on_tensor)
+        return result
+
+    async def acpu(tensor: torch.Tensor) -> torch.Tensor:
+        """Awaitable variant of cpu_async() for use with asyncio.
+
+        Args:
+            tensor: Remote tensor
+
+        Returns:
+            CPU copy of the tensor
+        """
+        return await asyncio.wrap_future(cpu_async(tensor))
+
+    async def aitem(tensor: torch.Tensor) -> Any:
+        """Awaitable variant of item_async() for use with asyncio.
+
+        Args:
+            tensor: Remote tensor with exactly one element
+
+        Returns:
+            Python number
+        """
+        return await asyncio.wrap_future(item_async(tensor))
+
     def is_available() -> bool:
         """Check if remote device support is available.
 
@@ -69,6 +283,9 @@ def _create_module() -> types.ModuleType:
     def get_rng_state(device: Union[int, torch.device]) -> torch.Tensor:
         """Get the random number generator state for a remote device.
 
+        The state is the Philox seed and offset tracked on the client, so this
+        never contacts the remote machine.
+
         Args:
             device: Remote device index or torch.device to get RNG state from
 
@@ -187,6 +404,22 @@ def _create_module() -> types.ModuleType:
     module.is_initialized = is_initialized  # type: ignore[assignment]
 
     module.device_count = device_count  # type: ignore[assignment]
+    module.current_device = current_device  # type: ignore[assignment]
+    module.set_device = set_device  # type: ignore[assignment]
+    module.host_memory_stats = host_memory_stats  # type: ignore[assignment]
+    module.empty_host_cache = empty_host_cache  # type: ignore[assignment]
+    module.synchronize = synchronize  # type: ignore[assignment]
+    module.cpu_async = cpu_async  # type: ignore[assignment]
+    module.item_async = item_async  # type: ignore[assignment]
+    module.acpu = acpu  # type: ignore[assignment]
+    module.aitem = aitem  # type: ignore[assignment]
+    module.set_transfer_compression = set_transfer_compression  # type: ignore[assignment]
+    module.transfer_stats = transfer_stats  # type: ignore[assignment]
+    module.storage_cache_stats = storage_cache_stats  # type: ignore[assignment]
+    module.set_storage_cache_limits = set_storage_cache_limits  # type: ignore[assignment]
+    module.batch_stats = batch_stats  # type: ignore[assignment]
+    module.wire_dtype = wire_dtype  # type: ignore[assignment]
+    module.set_wire_dtype = set_wire_dtype  # type: ignore[assignment]
     module.get_rng_state = get_rng_state  # type: ignore[assignment]
     module.set_rng_state = set_rng_state  # type: ignore[assignment]
     module.initial_seed = initial_seed  # type: ignore[assignment]
@@ -222,3 +455,4 @@ from .device import (  # noqa: E402
     get_all_machines,
     get_device_registry,
 )
+from ._safetensors import load_safetensors  # noqa: E402
@@ -1,14 +1,21 @@
 # Copyright (C) 2025 alyxya
 # SPDX-License-Identifier: AGPL-3.0-or-later
 
-from typing import Any, Dict, List, Tuple
+from concurrent.futures import Future
+from typing import Any, Dict, List, Optional, Tuple
 
 import torch
 from torch.utils._pytree import tree_map
 
 # Simple operation dispatch - no complex patterns needed
+from ._C import _get_default_generator, _philox_engine_inputs
 from ._logging import get_logger
-from ._tensor_utils import RemoteTensorMetadata
+from ._tensor_utils import (
+    TRANSFER_CHUNK_BYTES,
+    RemoteTensorMetadata,
+    is_pinned_host_tensor,
+)
+from ._wire_dtype import resolve_wire_dtype
 
 log = get_logger(__name__)
 
@@ -131,6 +138,28 @@ def _execute_meta_operation(
     return meta_result, original_tensors
 
 
+def _mutated_storage_ids(
+    op: torch._ops.OpOverload, args: Tuple[Any, ...], kwargs: Dict[str, Any]
+) -> List[int]:
+    """Get storage IDs of remote tensors an op writes through its arguments.
+
+    Ops such as _foreach_add_ or _fused_adam_ mutate their inputs without
+    returning them, so these writes do not show up among the outputs.
+    """
+    storage_ids = []
+    for index, argument in enumerate(op._schema.arguments):
+        if argument.alias_info is None or not argument.alias_info.is_write:
+            continue
+        if not argument.kwarg_only and index < len(args):
+            value = args[index]
+        else:
+            value = kwargs.get(argument.name)
+        for item in value if isinstance(value, (list, tuple)) else (value,):
+            if isinstance(item, torch.Tensor) and item.device.type == "mycelya":
+                storage_ids.append(item.untyped_storage().data_ptr())
+    return storage_ids
+
+
 def _create_output_tensors(
     meta_outputs: List, original_tensors: Dict, remote_device: torch.device
 ) -> tuple[List, List]:
@@ -173,6 +202,34 @@ def _create_output_tensors(
     return output_tensors, output_storage_ids
 
 
+def _reserve_rng_state(
+    generator: Optional[torch.Generator],
+    remote_device: torch.device,
+    meta_outputs: List,
+) -> Dict[str, int]:
+    """Reserve Philox counters for a random op on the client-side generator.
+
+    The remote generator only tracks (seed, offset); every random op advances
+    the offset locally and ships the reserved range with its RPC, so the op can
+    stay fire-and-forget while remaining reproducible.
+
+    Args:
+        generator: Explicit generator passed to the op, or None for the default
+        remote_device: Remote device the op runs on
+        meta_outputs: Meta tensors describing the op outputs
+
+    Returns:
+        Dict with "seed" and "offset" for the server-side generator
+    """
+    if generator is None:
+        generator = _get_default_generator(remote_device.index)
+
+    # One counter per output element is an upper bound on what any kernel draws
+    increment = max((t.numel() for t in meta_outputs), default=1)
+    seed, offset = _philox_engine_inputs(generator, max(increment, 1))
+    return {"seed": seed, "offset": offset}
+
+
 def _execute_view_operation(
     op: torch._ops.OpOverload, *args: Any, **kwargs: Any
 ) -> torch.Tensor:
@@ -201,6 +258,13 @@ def _execute_with_static_outputs(
 ) -> Any:
     """Execute operation using meta tensors for shape inference (original path)."""
 
+    # Step 1: Random ops take their RNG state from the client-side generator,
+    # which cannot be serialized, so strip it before meta and remote execution
+    is_random_op = torch.Tag.nondeterministic_seeded in op.tags
+    generator = kwargs.get("generator")
+    if "generator" in kwargs:
+        kwargs = {**kwargs, "generator": None}
+
     # Step 2: Execute the operation on meta tensors to determine outputs
     log.debug(f"🔧 Executing {op_name} on meta tensors for shape inference")
 
@@ -233,6 +297,12 @@ def _execute_with_static_outputs(
     else:
         output_tensors, output_storage_ids = [], []
 
+    rng_state = (
+        _reserve_rng_state(generator, remote_device, meta_outputs)
+        if is_random_op
+        else None
+    )
+
     # Step 4: Execute remotely
     processed_args, processed_kwargs, input_metadata = (
         args_to_metadata_with_placeholders(args, kwargs)
@@ -240,7 +310,13 @@ def _execute_with_static_outputs(
 
     orchestrator = _get_remote_orchestrator()
     orchestrator.execute_aten_operation(
-        op_name, input_metadata, output_storage_ids, processed_args, processed_kwargs
+        op_name,
+        input_metadata,
+        output_storage_ids,
+        processed_args,
+        processed_kwargs,
+        rng_state=rng_state,
+        mutated_storage_ids=_mutated_storage_ids(op, args, kwargs),
     )
 
     # Step 5: Correct output tensor shapes to match meta tensor shapes
@@ -302,6 +378,7 @@ def _execute_with_dynamic_outputs(
         processed_args,
         processed_kwargs,
         return_metadata=True,
+        mutated_storage_ids=_mutated_storage_ids(op, args, kwargs),
     )
 
     # Step 4: Update output tensor metadata from remote execution results
@@ -447,6 +524,7 @@ def copy_from_device(from_: torch.Tensor) -> torch.Tensor:
         stride=list(from_.stride()),
         storage_offset=from_.storage_offset(),
         dtype=str(from_.dtype),
+        storage_nbytes=from_.untyped_storage().nbytes(),
     )
 
     log.info(
@@ -455,7 +533,98 @@ def copy_from_device(from_: torch.Tensor) -> torch.Tensor:
     return result
 
 
-def copy_from_host_to_device(from_: torch.Tensor, to_: torch.Tensor) -> torch.Tensor:
+def copy_from_device_async(from_: torch.Tensor, to_: torch.Tensor) -> torch.Tensor:
+    """Queue a copy from a remote tensor into a CPU tensor without waiting.
+
+    The target is filled from the batch thread once the download completes, so
+    callers must synchronize the remote device before reading it.
+    """
+    if from_.device.type != "mycelya":
+        raise ValueError("copy_from_device_async requires a remote tensor")
+
+    from ._remote_orchestrator import remote_orchestrator
+
+    storage_id = from_.untyped_storage().data_ptr()
+    log.info(f"Queueing async copy of storage ID {storage_id} from remote to CPU")
+
+    download = remote_orchestrator.get_storage_tensor_async(
+        storage_id,
+        shape=list(from_.shape),
+        stride=list(from_.stride()),
+        storage_offset=from_.storage_offset(),
+        dtype=str(from_.dtype),
+    )
+
+    # Resolves once the data has landed in to_, not just when bytes arrive
+    copied = Future()
+
+    def _fill_target(done: Future) -> None:
+        try:
+            with torch.no_grad():
+                to_.copy_(done.result())
+            copied.set_result(to_)
+        except Exception as e:
+            copied.set_exception(e)
+
+    download.add_done_callback(_fill_target)
+    remote_orchestrator.track_async_copy(from_.device.index, copied)
+    return to_
+
+
+def download_async(from_: torch.Tensor) -> Future:
+    """Queue a download of a remote tensor into a new CPU tensor.
+
+    Unlike copy_from_device_async there is no target to fill, so the caller
+    gets the Future itself and can wait on or chain each result separately.
+
+    Args:
+        from_: Remote tensor to download
+
+    Returns:
+        Future resolving to a CPU tensor with from_'s shape and dtype
+    """
+    if from_.device.type != "mycelya":
+        raise ValueError("download_async requires a remote tensor")
+
+    from ._remote_orchestrator import remote_orchestrator
+
+    dtype = from_.dtype
+    with torch.no_grad():
+        wire = resolve_wire_dtype(from_, dtype)
+        if wire is not None:
+            from_ = from_.to(wire)
+
+    storage_id = from_.untyped_storage().data_ptr()
+    log.info(f"Queueing async download of storage ID {storage_id} to CPU")
+
+    download = remote_orchestrator.get_storage_tensor_async(
+        storage_id,
+        shape=list(from_.shape),
+        stride=list(from_.stride()),
+        storage_offset=from_.storage_offset(),
+        dtype=str(from_.dtype),
+    )
+    if wire is None:
+        result = download
+    else:
+        # Widen back to the tensor's own dtype on arrival
+        result = Future()
+
+        def _widen(done: Future) -> None:
+            try:
+                result.set_result(done.result().to(dtype))
+            except Exception as e:
+                result.set_exception(e)
+
+        download.add_done_callback(_widen)
+
+    remote_orchestrator.track_async_copy(from_.device.index, result)
+    return result
+
+
+def copy_from_host_to_device(
+    from_: torch.Tensor, to_: torch.Tensor, non_blocking: bool = False
+) -> torch.Tensor:
     """Copy data from CPU tensor to remote tensor using remote execution"""
     if to_.device.type != "mycelya":
         raise ValueError("copy_from_host_to_device requires a remote target tensor")
@@ -474,6 +643,23 @@ def copy_from_host_to_device(from_: torch.Tensor, to_: torch.Tensor) -> torch.Te
             f"No RemoteMachine found for remote device index {to_.device.index}"
         )
 
+    # Large blocking uploads are streamed as storage byte ranges, which needs
+    # a contiguous target of the source's shape and dtype. Otherwise stream
+    # into a remote staging tensor and let the device do the strided copy.
+    nbytes = from_.numel() * from_.element_size()
+    if (
+        not non_blocking
+        and nbytes >= TRANSFER_CHUNK_BYTES
+        and (
+            not to_.is_contiguous()
+            or to_.dtype != from_.dtype
+            or to_.shape != from_.shape
+        )
+    ):
+        staging = torch.empty(from_.shape, dtype=from_.dtype, device=to_.device)
+        copy_from_host_to_device(from_, staging)
+        return to_.copy_(staging)
+
     # Send tensor data using orchestrator for centralized client management
     storage_id = to_.untyped_storage().data_ptr()
     log.info(f"Copying CPU tensor to remote storage ID {storage_id}")
@@ -483,7 +669,7 @@ def copy_from_host_to_device(from_: torch.Tensor, to_: torch.Tensor) -> torch.Te
 
     # Use orchestrator to update tensor with automatic client routing
     # Pass source and target metadata for proper handling of partial updates
-    remote_orchestrator.update_storage(
+    future = remote_orchestrator.update_storage(
         storage_id,
         from_,  # Pass storage tensor directly
         source_shape=list(from_.shape),
@@ -494,7 +680,10 @@ def copy_from_host_to_device(from_: torch.Tensor, to_: torch.Tensor) -> torch.Te
         target_stride=list(to_.stride()),
         target_storage_offset=to_.storage_offset(),
         target_dtype=str(to_.dtype),
+        non_blocking=non_blocking,
     )
+    if future is not None:
+        remote_orchestrator.track_async_copy(to_.device.index, future)
     log.info(f"Successfully created/updated remote tensor with ID {storage_id}")
     return to_
 
@@ -511,7 +700,9 @@ def _copy_from(
     Args:
         from_: Source tensor to copy from
         to_: Target tensor to copy to
-        non_blocking: Whether to perform the copy asynchronously (currently ignored)
+        non_blocking: Whether to return before the copy completes. Uploads are
+            staged off-thread; downloads are asynchronous only into pinned
+            targets, matching CUDA. Use torch.mycelya.synchronize() to wait.
 
     Returns:
         Target tensor with copied data
@@ -522,12 +713,29 @@ def _copy_from(
     # Only support CPU ↔ remote transfers
 
     if from_.device.type == "mycelya" and to_.device.type == "cpu":
-        # Remote to CPU - supported
-        host_mem = copy_from_device(from_)
-        result = to_.copy_(host_mem)
+        # Remote to CPU - supported. With a reduced-precision wire policy the
+        # device narrows the data first; to_.copy_ widens it again on the CPU.
+        wire = resolve_wire_dtype(from_, to_.dtype)
+        if wire is not None:
+            from_ = from_.to(wire)
+        if non_blocking and is_pinned_host_tensor(to_):
+            result = copy_from_device_async(from_, to_)
+        else:
+            host_mem = copy_from_device(from_)
+            result = to_.copy_(host_mem)
     elif from_.device.type == "cpu" and to_.device.type == "mycelya":
-        # CPU to remote - supported
-        result = copy_from_host_to_device(from_, to_)
+        # CPU to remote - supported. With a reduced-precision wire policy the
+        # CPU narrows the data into a remote staging tensor and the device
+        # widens it into the target.
+        wire = resolve_wire_dtype(to_, from_.dtype)
+        if wire is not None:
+            staging = torch.empty(from_.shape, dtype=wire, device=to_.device)
+            copy_from_host_to_device(
+                from_.to(wire), staging, non_blocking=non_blocking
+            )
+            result = to_.copy_(staging)
+        else:
+            result = copy_from_host_to_device(from_, to_, non_blocking=non_blocking)
     elif from_.device.type == "mycelya" and to_.device.type == "mycelya":
         # Remote to remote transfers
         if from_.device.index == to_.device.index:
@@ -616,6 +824,7 @@ def _local_scalar_dense(self: torch.Tensor):
         stride=list(self.stride()),
         storage_offset=self.storage_offset(),
         dtype=str(self.dtype),
+        storage_nbytes=self.untyped_storage().nbytes(),
     )
 
     # Call item() on the CPU tensor to get the Python scalar
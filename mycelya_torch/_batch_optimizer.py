@@ -0,0 +1,248 @@
+# Copyright (C) 2025 alyxya
+# SPDX-License-Identifier: AGPL-3.0-or-later
+
+"""
+Peephole optimizer for RPC batches.
+
+Runs over a batch right before it is sent and removes calls whose effects
+can never be observed:
+
+- create_storage/remove_storage pairs of a storage nobody reads in between
+  are cancelled, along with the writes and resizes they enclose
+- writes whose bytes are overwritten before anything reads them are dropped,
+  and packed upload entries are trimmed to the bytes no later write covers
+- chains of resize_storage calls collapse into one resize to the final size
+
+Calls are matched on the storage IDs they read and write (see BatchedRPC); a
+call whose reads are unknown acts as a barrier. Only fire-and-forget calls
+are removed. The batch is scanned backwards while tracking, per storage, the
+byte ranges later calls overwrite before any read.
+"""
+
+import math
+from typing import Any, Dict, List, Optional, Tuple
+
+import torch
+
+from ._batching import BatchedRPC, DeferredArg
+
+Range = Tuple[float, float]
+
+# Byte range standing for the whole storage, whatever its size
+_WHOLE_STORAGE: Range = (0, math.inf)
+
+
+def _subtract(start: float, end: float, covered: List[Range]) -> List[Range]:
+    """Get the parts of [start, end) outside the covered ranges."""
+    pieces = [(start, end)] if end > start else []
+    for a, b in covered:
+        remaining = []
+        for s, e in pieces:
+            if b <= s or a >= e:
+                remaining.append((s, e))
+                continue
+            if s < a:
+                remaining.append((s, a))
+            if b < e:
+                remaining.append((b, e))
+        pieces = remaining
+    return pieces
+
+
+def _cover(covered: List[Range], start: float, end: float) -> List[Range]:
+    """Add [start, end) to sorted, disjoint covered ranges."""
+    merged = []
+    for a, b in sorted(covered + [(start, end)]):
+        if merged and a <= merged[-1][1]:
+            merged[-1] = (merged[-1][0], max(merged[-1][1], b))
+        else:
+            merged.append((a, b))
+    return merged
+
+
+def _view_range(
+    shape: List[int], stride: List[int], offset: int, dtype: str
+) -> Tuple[int, int, bool]:
+    """
+    Get the bytes a strided view spans.
+
+    Returns:
+        Tuple of (start byte, end byte, whether the view writes every byte
+        in between)
+    """
+    itemsize = getattr(torch, dtype.replace("torch.", "")).itemsize
+    if math.prod(shape) == 0:
+        return offset * itemsize, offset * itemsize, True
+
+    last = offset + sum((size - 1) * step for size, step in zip(shape, stride))
+    dense, expected = True, 1
+    for size, step in reversed(list(zip(shape, stride))):
+        if size != 1 and step != expected:
+            dense = False
+        expected *= size
+    return offset * itemsize, (last + 1) * itemsize, dense
+
+
+def _write_extents(call: BatchedRPC) -> Optional[List[Tuple[int, Any, Any, bool]]]:
+    """
+    Get the byte ranges a storage write call modifies.
+
+    Returns:
+        List of (storage_id, start, end, dense) per written range, where dense
+        means every byte in the range is written, or None if the call is not a
+        plain storage write
+    """
+    if call.method_name == "update_storage":
+        storage_id, *_, shape, stride, offset, dtype = call.args
+        return [(storage_id, *_view_range(shape, stride, offset, dtype))]
+
+    if call.method_name == "write_storage_bytes":
+        storage_id, byte_offset, payload = call.args
+        if isinstance(payload, (tuple, DeferredArg)):
+            # Compressed or not yet staged: the raw length is unknown
+            return [(storage_id, *_WHOLE_STORAGE, False)]
+        nbytes = getattr(payload, "nbytes", None)
+        if nbytes is None:
+            nbytes = len(payload)
+        return [(storage_id, byte_offset, byte_offset + nbytes, True)]
+
+    if call.method_name == "write_storages_packed":
+        entries, _ = call.args
+        return [
+            (storage_id, byte_offset, byte_offset + nbytes, True)
+            for storage_id, byte_offset, _, nbytes in entries
+        ]
+
+    return None
+
+
+def optimize_batch(
+    batch: List[BatchedRPC],
+) -> Tuple[List[BatchedRPC], List[BatchedRPC]]:
+    """
+    Remove calls of a batch whose effects are never observed.
+
+    Args:
+        batch: Calls in queue order
+
+    Returns:
+        Tuple of (calls to send, in order, and calls eliminated)
+    """
+    if len(batch) < 2:
+        return batch, []
+
+    kept: List[Optional[BatchedRPC]] = list(batch)
+    # storage_id -> byte ranges overwritten by later calls before any read
+    covered: Dict[int, List[Range]] = {}
+    # storage_id -> index of a remove_storage no kept call has touched since
+    removals: Dict[int, int] = {}
+    # storage_id -> index of the next resize_storage, if nothing touches the
+    # storage in between
+    resizes: Dict[int, int] = {}
+
+    def touch(storage_id: int) -> None:
+        removals.pop(storage_id, None)
+        resizes.pop(storage_id, None)
+
+    def read(storage_id: int) -> None:
+        covered.pop(storage_id, None)
+        touch(storage_id)
+
+    for i in range(len(batch) - 1, -1, -1):
+        call = batch[i]
+        if call.reads is None:
+            # Anything may be read here; nothing later can shadow it
+            covered.clear()
+            removals.clear()
+            resizes.clear()
+            continue
+
+        if call.call_type != "spawn":
+            for storage_id in call.writes:
+                touch(storage_id)
+            for storage_id in call.reads:
+                read(storage_id)
+            continue
+
+        if call.method_name == "remove_storage":
+            storage_id = call.args[0]
+            covered[storage_id] = [_WHOLE_STORAGE]
+            resizes.pop(storage_id, None)
+            removals[storage_id] = i
+            continue
+
+        if call.method_name == "create_storage":
+            storage_id = call.args[0]
+            removal = removals.pop(storage_id, None)
+            if removal is not None:
+                kept[i] = kept[removal] = None
+            # Earlier calls refer to a previous storage with this ID
+            covered.pop(storage_id, None)
+            resizes.pop(storage_id, None)
+            continue
+
+        if call.method_name == "resize_storage":
+            storage_id, nbytes = call.args
+            if _WHOLE_STORAGE in covered.get(storage_id, ()):
+                kept[i] = None
+                continue
+            later = resizes.get(storage_id)
+            if later is not None:
+                # Storages only grow, so the chain ends at its largest size
+                final = kept[later]
+                kept[later] = final._replace(
+                    args=(storage_id, max(nbytes, final.args[1]))
+                )
+                kept[i] = None
+                continue
+            # Resizing carries the current bytes over, which reads them
+            read(storage_id)
+            resizes[storage_id] = i
+            continue
+
+        extents = _write_extents(call)
+        if extents is None:
+            for storage_id in call.writes:
+                touch(storage_id)
+            for storage_id in call.reads:
+                read(storage_id)
+            continue
+
+        live = [
+            _subtract(start, end, covered.get(storage_id, []))
+            for storage_id, start, end, _ in extents
+        ]
+        if not any(live):
+            kept[i] = None
+            continue
+
+        if call.method_name == "write_storages_packed":
+            # Trim entries to the one contiguous part later writes leave
+            entries, payload = call.args
+            trimmed = []
+            for entry, pieces in zip(entries, live):
+                if len(pieces) == 1:
+                    storage_id, byte_offset, payload_offset, _ = entry
+                    start, end = int(pieces[0][0]), int(pieces[0][1])
+                    shift = start - byte_offset
+                    entry = (storage_id, start, payload_offset + shift, end - start)
+                if pieces:
+                    trimmed.append(entry)
+            if trimmed != list(entries):
+                kept[i] = call._replace(
+                    args=(trimmed, payload),
+                    writes=tuple(entry[0] for entry in trimmed),
+                )
+            extents = [
+                (storage_id, byte_offset, byte_offset + nbytes, True)
+                for storage_id, byte_offset, _, nbytes in trimmed
+            ]
+
+        for storage_id, start, end, dense in reversed(extents):
+            touch(storage_id)
+            if dense and end > start:
+                covered[storage_id] = _cover(covered.get(storage_id, []), start, end)
+
+    optimized = [call for call in kept if call is not None]
+    eliminated = [call for call, result in zip(batch, kept) if result is None]
+    return optimized, eliminated
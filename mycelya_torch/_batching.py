@@ -8,25 +8,115 @@ This module provides thread-safe batching of RPCs to reduce network overhead
 and improve overall system performance by grouping multiple operations together.
 """
 
+import contextlib
 import threading
 import time
-from concurrent.futures import Future
-from dataclasses import dataclass, field
-from queue import Empty, Queue
-from typing import Any, Dict, List, Optional, Union
+import uuid
+import weakref
+from abc import ABC, abstractmethod
+from concurrent.futures import Future, ThreadPoolExecutor
+from dataclasses import dataclass
+from typing import (
+    Any,
+    Callable,
+    Dict,
+    Iterable,
+    Iterator,
+    List,
+    NamedTuple,
+    Optional,
+    Set,
+    Tuple,
+    Union,
+)
 
 from ._logging import get_logger
+from ._op_templates import OpTemplateEncoder
 
 log = get_logger(__name__)
 
+# Batches a client keeps in flight by default, and at most, plus one on the
+# priority lane. The server accepts at least MAX_BATCH_WINDOW + 1 concurrent
+# batches so ordering never deadlocks.
+DEFAULT_BATCH_WINDOW = 4
+MAX_BATCH_WINDOW = 16
 
-@dataclass
-class BatchedRPC:
+# Pending work a client may queue before producers wait for the sender to
+# drain it. The limits are soft: producers released together may overshoot
+# them by one call each.
+DEFAULT_MAX_PENDING_CALLS = 65536
+DEFAULT_MAX_PENDING_BYTES = 256 * 1024 * 1024
+
+# Threads that must never wait on a full queue: the sender, batch workers and
+# anything queueing calls while holding a lock the sender needs
+_backpressure = threading.local()
+
+
+def exempt_from_backpressure() -> None:
+    """Never make the calling thread wait on a full queue."""
+    _backpressure.exempt = True
+
+
+@contextlib.contextmanager
+def no_backpressure() -> Iterator[None]:
+    """Queue calls in this block without waiting on a full queue."""
+    previous = getattr(_backpressure, "exempt", False)
+    _backpressure.exempt = True
+    try:
+        yield
+    finally:
+        _backpressure.exempt = previous
+
+
+class DeferredArg(ABC):
+    """
+    RPC argument whose value is produced asynchronously.
+
+    The call is queued immediately so it keeps its place in the op stream;
+    the value is only resolved when the batch is serialized for sending.
+    """
+
+    @abstractmethod
+    def resolve(self) -> Any:
+        """Block until the value is ready and return it."""
+        pass
+
+    @property
+    def nbytes(self) -> int:
+        """Payload bytes the resolved value will carry, if known."""
+        return 0
+
+    def discard(self) -> None:
+        """Release the pending value of a call that will never be sent."""
+        pass
+
+
+def _resolve_args(args: tuple) -> tuple:
+    """Resolve any DeferredArg placeholders in an RPC argument tuple."""
+    if not any(isinstance(arg, DeferredArg) for arg in args):
+        return args
+    return tuple(
+        arg.resolve() if isinstance(arg, DeferredArg) else arg for arg in args
+    )
+
+
+def _payload_nbytes(value: Any) -> int:
+    """Estimate the payload bytes carried by an RPC argument."""
+    if isinstance(value, (bytes, bytearray)):
+        return len(value)
+    if isinstance(value, tuple):
+        return sum(_payload_nbytes(item) for item in value)
+    nbytes = getattr(value, "nbytes", None)
+    return nbytes if isinstance(nbytes, int) else 0
+
+
+class BatchedRPC(NamedTuple):
     """
     Represents a single RPC that has been queued for batching.
 
     This encapsulates all the information needed to execute an RPC
-    along with metadata for batching and future handling.
+    along with the future for its result. Kept as a plain tuple so queueing
+    a call costs one small allocation.
     """
 
     call_type: str  # "spawn" (fire-and-forget) or "remote" (blocking)
@@ -34,10 +124,79 @@ class BatchedRPC:
     args: tuple
     kwargs: dict
     future: Optional[Future] = None  # Only populated for "remote" calls
-    queued_at: float = field(default_factory=time.time)  # For cache invalidation timing
-    call_id: str = field(
-        default_factory=lambda: f"call_{id(object())}"
-    )  # Unique ID for debugging
+    writes: Tuple[int, ...] = ()  # Storage IDs the call modifies
+    reads: Optional[Tuple[int, ...]] = None  # Storage IDs it reads, if known
+    priority: bool = False  # Sent ahead of bulk traffic (see get_dependent_batch)
+
+
+Footprint = Tuple[Optional[Set[int]], Set[int]]  # (reads, writes) of calls
+
+
+def _footprint(calls: List[BatchedRPC]) -> Footprint:
+    """Get the storage IDs calls read, or None if unknown, and write."""
+    reads: Optional[Set[int]] = set()
+    writes: Set[int] = set()
+    for call in calls:
+        if call.reads is None:
+            reads = None
+        elif reads is not None:
+            reads.update(call.reads)
+        writes.update(call.writes)
+    return reads, writes
+
+
+def _conflicts(
+    footprint: Footprint, reads: Optional[Iterable[int]], writes: Iterable[int]
+) -> bool:
+    """
+    Check whether calls of a footprint and calls reading and writing the given
+    storage IDs must stay ordered.
+
+    They must if one side writes a storage the other reads or writes, or if
+    the reads of either side are unknown.
+    """
+    footprint_reads, footprint_writes = footprint
+    if footprint_reads is None or reads is None:
+        return True
+    return (
+        not footprint_writes.isdisjoint(reads)
+        or not footprint_writes.isdisjoint(writes)
+        or not footprint_reads.isdisjoint(writes)
+    )
+
+
+def _dependencies(calls: List[BatchedRPC], targets: List[int]) -> List[int]:
+    """
+    Get the calls that must be sent with the target calls.
+
+    Scans backwards from the last target; a call is needed if it conflicts
+    with a needed call after it. A call left out before the last target thus
+    never conflicts with a later call sent ahead of it, so the batch may go
+    out on another lane; calls left out after it are ordered against it by
+    the pipeline once it is in flight.
+
+    Returns:
+        Indices of the targets and every call they depend on, in queue order
+    """
+    wanted = set(targets)
+    needed: List[int] = []
+    reads: Optional[Set[int]] = set()
+    writes: Set[int] = set()
+    for i in range(max(targets), -1, -1):
+        call = calls[i]
+        if i not in wanted and not (
+            needed and _conflicts((reads, writes), call.reads, call.writes)
+        ):
+            continue
+        needed.append(i)
+        if call.reads is None:
+            # Everything before a call with unknown reads stays before it
+            reads = None
+        elif reads is not None:
+            reads.update(call.reads)
+        writes.update(call.writes)
+    needed.reverse()
+    return needed
 
 
 @dataclass
@@ -53,14 +212,23 @@ class BatchExecutionResult:
     success_count: int
     error_count: int
     execution_time: float
+    eliminated_count: int = 0  # Calls removed by the batch optimizer
+    lost: bool = False  # The batch RPC itself failed; it may not have run
 
 
 class RPCBatchQueue:
     """
     Thread-safe queue for batching RPCs.
 
-    This queue collects RPCs from the main thread and allows
-    a background thread to process them in batches for improved performance.
+    This queue collects RPCs from any thread and allows a background thread
+    to process them in batches for improved performance. Calls are held in a
+    lock-free native queue: producers push with a single atomic operation and
+    never serialize on a Python lock, and the background thread takes all
+    pending calls in one swap.
+
+    Calls record the storage IDs they write and, when known, read. Calls on
+    the priority lane and blocking reads can then be sent with only the calls
+    they depend on while bulk traffic stays queued (see get_dependent_batch).
     """
 
     def __init__(self, client_id: str):
@@ -70,15 +238,104 @@ class RPCBatchQueue:
         Args:
             client_id: Unique identifier for the client (for logging/debugging)
         """
+        from ._C import (
+            _rpc_queue_drain,
+            _rpc_queue_free,
+            _rpc_queue_new,
+            _rpc_queue_push,
+            _rpc_queue_state,
+        )
+
         self.client_id = client_id
-        self._queue: Queue[BatchedRPC] = Queue()
-        self._lock = threading.RLock()  # Re-entrant lock for nested operations
+        self._handle = _rpc_queue_new()
+        self._push = _rpc_queue_push
+        self._drain = _rpc_queue_drain
+        self._state = _rpc_queue_state
+        # Frees the native queue and any calls still in it
+        weakref.finalize(self, _rpc_queue_free, self._handle)
+
+        # Calls drained but held back by get_dependent_batch, in queue order.
+        # Only modified by the consumer thread.
+        self._held: List[BatchedRPC] = []
+        self._held_bytes = 0
+        self._held_since = 0.0
+        self._held_blocking = False
+        self._dependent_flushes = 0
+        self._priority_flushes = 0
+
+        # Backpressure: producers over a limit wait on _space until a drain
+        self._max_pending_calls = DEFAULT_MAX_PENDING_CALLS
+        self._max_pending_bytes = DEFAULT_MAX_PENDING_BYTES
+        self._space = threading.Condition()
+        self._stalls = 0
+        self._stall_time = 0.0
+        self._max_stall = 0.0
 
-        # Statistics for monitoring
-        self._queued_calls = 0
-        self._processed_calls = 0
         self._last_batch_time = time.time()
 
+    def set_limits(
+        self, max_calls: Optional[int] = None, max_bytes: Optional[int] = None
+    ) -> None:
+        """
+        Set how much work may be pending before producers wait.
+
+        Args:
+            max_calls: Pending call limit, or None for the default
+            max_bytes: Pending payload byte limit, or None for the default
+
+        Raises:
+            ValueError: If a limit is not positive
+        """
+        for name, value in (("max_calls", max_calls), ("max_bytes", max_bytes)):
+            if value is not None and value <= 0:
+                raise ValueError(f"{name} must be positive, got {value}")
+        with self._space:
+            self._max_pending_calls = (
+                DEFAULT_MAX_PENDING_CALLS if max_calls is None else max_calls
+            )
+            self._max_pending_bytes = (
+                DEFAULT_MAX_PENDING_BYTES if max_bytes is None else max_bytes
+            )
+            self._space.notify_all()
+
+    def _is_full(self, nbytes: int) -> bool:
+        """Check whether queueing nbytes more would exceed a limit."""
+        calls, pending_bytes, _, _ = self.pending()
+        # A call larger than the byte limit still goes through on its own
+        return calls > 0 and (
+            calls >= self._max_pending_calls
+            or pending_bytes + nbytes > self._max_pending_bytes
+        )
+
+    def wait_for_capacity(
+        self, nbytes: int = 0, on_stall: Optional[Callable[[], None]] = None
+    ) -> None:
+        """
+        Block until a call carrying nbytes fits within the pending limits.
+
+        Returns immediately on threads exempt from backpressure.
+
+        Args:
+            nbytes: Payload bytes of the call about to be queued
+            on_stall: Called once before waiting, e.g. to wake the sender
+        """
+        if getattr(_backpressure, "exempt", False) or not self._is_full(nbytes):
+            return
+
+        if on_stall is not None:
+            on_stall()
+        start = time.monotonic()
+        with self._space:
+            while self._is_full(nbytes):
+                # Drains notify under the same lock; the timeout only guards
+                # against limits changing without a drain
+                self._space.wait(0.1)
+            stalled = time.monotonic() - start
+            self._stalls += 1
+            self._stall_time += stalled
+            self._max_stall = max(self._max_stall, stalled)
+        log.debug(f"⏳ Queue for client {self.client_id} stalled for {stalled:.3f}s")
+
     def enqueue_call(
         self,
         call_type: str,
@@ -86,6 +343,9 @@ class RPCBatchQueue:
         args: tuple,
         kwargs: dict,
         return_future: bool = False,
+        writes: Tuple[int, ...] = (),
+        reads: Optional[Tuple[int, ...]] = None,
+        priority: bool = False,
     ) -> Optional[Future]:
         """
         Add an RPC to the batch queue.
@@ -96,92 +356,180 @@ class RPCBatchQueue:
             args: Arguments for the RPC method
             kwargs: Keyword arguments for the RPC method
             return_future: Whether to return a Future for this call
+            writes: Storage IDs the call modifies
+            reads: Storage IDs the call reads, or None if unknown
+            priority: Whether the call belongs to the priority lane, e.g.
+                because it was queued on a high-priority stream
 
         Returns:
             Future object if return_future=True, None otherwise
         """
-        with self._lock:
-            future = None
-            if return_future or call_type == "remote":
-                future = Future()
-
-            call = BatchedRPC(
-                call_type=call_type,
-                method_name=method_name,
-                args=args,
-                kwargs=kwargs,
-                future=future,
-            )
+        future = None
+        if return_future or call_type == "remote":
+            future = Future()
 
-            self._queue.put(call)
-            self._queued_calls += 1
+        call = BatchedRPC(
+            call_type, method_name, args, kwargs, future, writes, reads, priority
+        )
+        # Priority calls are flushed right away, like calls someone waits on
+        self._push(
+            self._handle, call, _payload_nbytes(args), future is not None or priority
+        )
 
-            log.debug(
-                f"📦 Queued {call_type} call: {method_name} for client {self.client_id}"
-            )
+        log.debug(
+            f"📦 Queued {call_type} call: {method_name} for client {self.client_id}"
+        )
 
-            return future
+        return future
 
     def get_batch(self, timeout: float = 0.01) -> List[BatchedRPC]:
         """
         Retrieve all currently queued calls as a batch.
 
         Args:
-            timeout: Maximum time to wait for calls (in seconds)
+            timeout: Unused; retrieval never blocks
+
+        Returns:
+            List of BatchedRPC objects ready for execution, in queue order
+        """
+        batch = self._take_all()
+
+        if batch:
+            self._last_batch_time = time.time()
+            log.debug(
+                f"📋 Retrieved batch of {len(batch)} calls for client {self.client_id}"
+            )
+
+        return batch
+
+    def get_dependent_batch(self) -> List[BatchedRPC]:
+        """
+        Retrieve urgent calls and only the calls they depend on.
+
+        Calls on the priority lane are urgent. Without any, the first call
+        returning a Future is, if it is a pure read; it then joins the
+        priority lane. Urgent calls are sent with the earlier calls they
+        conflict with, directly or through another call sent with them, while
+        the rest stay queued and keep batching. Anything else (a blocking
+        write or unknown read, no blocking call) takes the whole queue, since
+        the caller waits on everything before it anyway.
 
         Returns:
-            List of BatchedRPC objects ready for execution
-        """
-        with self._lock:
-            batch = []
-
-            # Get all available calls without blocking
-            try:
-                while True:
-                    call = self._queue.get_nowait()
-                    batch.append(call)
-                    self._queue.task_done()
-            except Empty:
-                pass
-
-            if batch:
-                self._processed_calls += len(batch)
-                self._last_batch_time = time.time()
-                log.debug(
-                    f"📋 Retrieved batch of {len(batch)} calls for client {self.client_id}"
+            List of BatchedRPC objects ready for execution, in queue order
+        """
+        age = self.pending()[2]
+        calls = self._take_all()
+        urgent = [i for i, call in enumerate(calls) if call.priority]
+        if urgent:
+            self._priority_flushes += 1
+        else:
+            target = next(
+                (i for i, c in enumerate(calls) if c.future is not None), None
+            )
+            if (
+                target is not None
+                and not calls[target].writes
+                and calls[target].reads is not None
+            ):
+                calls[target] = calls[target]._replace(priority=True)
+                urgent = [target]
+
+        batch = calls
+        if urgent:
+            needed = _dependencies(calls, urgent)
+            if len(needed) < len(calls):
+                batch = [calls[i] for i in needed]
+                needed_set = set(needed)
+                self._hold(
+                    [call for i, call in enumerate(calls) if i not in needed_set],
+                    age,
                 )
+                self._dependent_flushes += 1
+
+        if batch:
+            self._last_batch_time = time.time()
+            log.debug(
+                f"📋 Retrieved batch of {len(batch)} calls for client "
+                f"{self.client_id} ({len(self._held)} held back)"
+            )
 
-            return batch
+        return batch
+
+    def _take_all(self) -> List[BatchedRPC]:
+        """Take held calls followed by everything queued since."""
+        held, self._held = self._held, []
+        self._held_bytes = 0
+        self._held_blocking = False
+        calls = held + self._drain(self._handle)
+        with self._space:
+            self._space.notify_all()
+        return calls
+
+    def _hold(self, calls: List[BatchedRPC], age: float) -> None:
+        """Keep calls for the next batch, ahead of anything queued later."""
+        self._held = calls
+        self._held_bytes = sum(_payload_nbytes(call.args) for call in calls)
+        # Held calls keep the age of the batch they came from
+        self._held_since = time.monotonic() - age
+        self._held_blocking = any(
+            call.future is not None or call.priority for call in calls
+        )
+
+    def pending(self) -> Tuple[int, int, float, bool]:
+        """
+        Get a summary of the calls waiting to be sent.
+
+        Returns:
+            Tuple of (call count, payload bytes, seconds the oldest call has
+            waited, whether any call returns a Future)
+        """
+        calls, nbytes, age, blocking, _, _ = self._state(self._handle)
+        if self._held:
+            calls += len(self._held)
+            nbytes += self._held_bytes
+            age = max(age, time.monotonic() - self._held_since)
+            blocking = blocking or self._held_blocking
+        return calls, nbytes, age, blocking
 
     def get_stats(self) -> Dict[str, Any]:
         """
         Get statistics about the batch queue.
 
         Returns:
-            Dictionary containing queue statistics
+            Dictionary containing queue statistics, including the pending
+            limits and how often and how long producers waited on them
         """
-        with self._lock:
-            return {
-                "client_id": self.client_id,
-                "queue_size": self._queue.qsize(),
-                "queued_calls": self._queued_calls,
-                "processed_calls": self._processed_calls,
-                "last_batch_time": self._last_batch_time,
-                "pending_calls": self._queued_calls - self._processed_calls,
+        calls, nbytes, _, _, queued, processed = self._state(self._handle)
+        calls += len(self._held)
+        nbytes += self._held_bytes
+        with self._space:
+            backpressure = {
+                "max_pending_calls": self._max_pending_calls,
+                "max_pending_bytes": self._max_pending_bytes,
+                "stalls": self._stalls,
+                "stall_time": self._stall_time,
+                "max_stall": self._max_stall,
             }
+        return {
+            "client_id": self.client_id,
+            "queue_size": calls,
+            "queued_calls": queued,
+            "processed_calls": processed,
+            "last_batch_time": self._last_batch_time,
+            "pending_calls": calls,
+            "pending_bytes": nbytes,
+            "held_calls": len(self._held),
+            "dependent_flushes": self._dependent_flushes,
+            "priority_flushes": self._priority_flushes,
+            "backpressure": backpressure,
+        }
 
     def clear(self) -> None:
         """Clear all pending calls from the queue."""
-        with self._lock:
-            while not self._queue.empty():
-                try:
-                    call = self._queue.get_nowait()
-                    if call.future:
-                        call.future.cancel()
-                    self._queue.task_done()
-                except Empty:
-                    break
-            log.info(f"🧹 Cleared batch queue for client {self.client_id}")
+        for call in self._take_all():
+            if call.future:
+                call.future.cancel()
+        log.info(f"🧹 Cleared batch queue for client {self.client_id}")
 
 
 class BatchProcessor:
@@ -192,39 +540,109 @@ class BatchProcessor:
     that blocking calls receive their results through the Future mechanism.
     """
 
+    @staticmethod
+    def optimize_batch(
+        batch: List[BatchedRPC],
+    ) -> Tuple[List[BatchedRPC], List[BatchedRPC]]:
+        """
+        Remove calls whose effects are never observed (see _batch_optimizer).
+
+        Args:
+            batch: List of batched RPCs
+
+        Returns:
+            Tuple of (calls to send, calls eliminated). Futures of eliminated
+            calls are resolved by complete_eliminated once the batch is done.
+        """
+        from ._batch_optimizer import optimize_batch
+
+        batch, eliminated = optimize_batch(batch)
+        for call in eliminated:
+            for arg in call.args:
+                if isinstance(arg, DeferredArg):
+                    arg.discard()
+        if eliminated:
+            log.info(f"✂️ Batch optimizer eliminated {len(eliminated)} calls")
+        return batch, eliminated
+
+    @staticmethod
+    def complete_eliminated(
+        eliminated: List[BatchedRPC], error: Optional[Exception] = None
+    ) -> None:
+        """Resolve the futures of eliminated calls like their batch's calls."""
+        for call in eliminated:
+            if call.future and not call.future.done():
+                if error is None:
+                    call.future.set_result(None)
+                else:
+                    call.future.set_exception(error)
+
+    @staticmethod
+    def prepare_batch(batch: List[BatchedRPC]) -> List[Dict[str, Any]]:
+        """
+        Convert BatchedRPC objects to the format expected by execute_batch.
+
+        Deferred arguments are resolved here, so this blocks until their
+        values are ready.
+
+        Args:
+            batch: List of batched RPCs
+
+        Returns:
+            List of call dictionaries for the server's execute_batch
+        """
+        return [
+            {
+                "method_name": call.method_name,
+                "call_type": call.call_type,
+                "args": _resolve_args(call.args),
+                "kwargs": call.kwargs,
+            }
+            for call in batch
+        ]
+
     @staticmethod
     def execute_batch(
-        server_instance: Any, batch: List[BatchedRPC]
+        server_instance: Any,
+        batch: List[BatchedRPC],
+        batch_calls: Optional[List[Dict[str, Any]]] = None,
+        order: Optional[Tuple[str, int]] = None,
+        eliminated: Optional[List[BatchedRPC]] = None,
     ) -> BatchExecutionResult:
         """
         Execute a batch of RPCs on the server instance using the batched RPC method.
 
+        Unless the batch was already prepared, it first goes through
+        optimize_batch so calls with no observable effect are never sent.
+
         Args:
             server_instance: The Modal server instance to execute calls on
             batch: List of batched RPCs to execute
+            batch_calls: The batch already optimized and converted by
+                prepare_batch, if any
+            order: (session, sequence number) the server executes batches
+                of a session in, or None to execute on arrival
+            eliminated: Calls optimize_batch removed from an already
+                prepared batch, resolved along with it
 
         Returns:
             BatchExecutionResult containing results and statistics
         """
+        if batch_calls is None:
+            batch, eliminated = BatchProcessor.optimize_batch(batch)
+        eliminated = eliminated or []
+
         if not batch:
-            return BatchExecutionResult([], 0, 0, 0.0)
+            BatchProcessor.complete_eliminated(eliminated)
+            return BatchExecutionResult([], 0, 0, 0.0, len(eliminated))
 
         start_time = time.time()
 
         log.info(f"🚀 Executing batch of {len(batch)} RPCs using batched RPC")
 
         try:
-            # Convert BatchedRPC objects to the format expected by execute_batch
-            batch_calls = []
-            for call in batch:
-                batch_call = {
-                    "method_name": call.method_name,
-                    "call_type": call.call_type,
-                    "args": call.args,
-                    "kwargs": call.kwargs,
-                    "call_id": call.call_id,
-                }
-                batch_calls.append(batch_call)
+            if batch_calls is None:
+                batch_calls = BatchProcessor.prepare_batch(batch)
 
             log.info(
                 f"🔍 DEBUG: About to call server_instance.execute_batch.remote() with {len(batch_calls)} calls"
@@ -235,7 +653,12 @@ class BatchProcessor:
             )
 
             # Execute all calls in a single batched RPC
-            results = server_instance.execute_batch.remote(batch_calls)
+            if order is None:
+                results = server_instance.execute_batch.remote(batch_calls)
+            else:
+                results = server_instance.execute_batch.remote(
+                    batch_calls, order=order
+                )
 
             log.info(f"🔍 DEBUG: Batched RPC completed, results type: {type(results)}")
 
@@ -253,6 +676,7 @@ class BatchProcessor:
                     if call.future:
                         call.future.set_result(result)
 
+            BatchProcessor.complete_eliminated(eliminated)
             execution_time = time.time() - start_time
 
             log.info(
@@ -264,6 +688,7 @@ class BatchProcessor:
                 success_count=success_count,
                 error_count=error_count,
                 execution_time=execution_time,
+                eliminated_count=len(eliminated),
             )
 
         except Exception as e:
@@ -273,6 +698,7 @@ class BatchProcessor:
             for call in batch:
                 if call.future:
                     call.future.set_exception(e)
+            BatchProcessor.complete_eliminated(eliminated, e)
 
             execution_time = time.time() - start_time
 
@@ -281,4 +707,233 @@ class BatchProcessor:
                 success_count=0,
                 error_count=len(batch),
                 execution_time=execution_time,
+                eliminated_count=len(eliminated),
+                lost=True,
+            )
+
+
+class BatchPipeline:
+    """
+    Sends a client's batches with several of them in flight at once.
+
+    Batches are numbered in the order they are submitted and the server
+    executes each session's batches strictly in that order, so a new batch
+    can travel to the server while earlier ones are still executing and
+    network latency overlaps with remote execution. Futures of each batch
+    resolve as soon as its own results arrive.
+
+    Repeated execute_aten_operation calls are sent as references into the
+    session's op template table (see _op_templates).
+
+    Batches go out on one of two lanes, each its own session with its own
+    sequence and template table. Priority batches therefore never wait on
+    the server for bulk batches still in transit, and one may go out beyond
+    a window full of bulk batches. A batch only overtakes batches of the other
+    lane it shares no storages with: it is held back until conflicting ones
+    in flight have completed.
+
+    When a batch RPC fails (lost in transit, or dropped by the server because
+    an earlier batch never arrived), its lane starts a new session with an
+    empty template table once the lane's batches still in flight have
+    completed, so the new session never passes the old one. Those batches
+    stay in the old session, where the server fails them rather than run
+    them out of order.
+    """
+
+    def __init__(self, client_id: str, window: int = DEFAULT_BATCH_WINDOW):
+        """
+        Initialize the pipeline for a specific client.
+
+        Args:
+            client_id: Unique identifier for the client (for logging/debugging)
+            window: Maximum number of batches in flight
+        """
+        self.client_id = client_id
+        # Per lane, keyed by whether it is the priority lane
+        self._sessions = {lane: uuid.uuid4().hex for lane in (False, True)}
+        self._next_seq = {False: 0, True: 0}
+        self._templates = {lane: OpTemplateEncoder() for lane in (False, True)}
+        self._sent_batches = {False: 0, True: 0}
+        # Lanes whose session is abandoned, switched once they drain
+        self._restarting = {False: False, True: False}
+        # Batches in flight: token -> (lane, footprint)
+        self._inflight: Dict[int, Tuple[bool, Footprint]] = {}
+        self._next_token = 0
+        self._window = 1
+        self._eliminated_calls = 0
+        self._cond = threading.Condition()
+        self._executor = ThreadPoolExecutor(
+            max_workers=MAX_BATCH_WINDOW + 1,
+            thread_name_prefix=f"RPCBatchWorker-{client_id}",
+            initializer=exempt_from_backpressure,
+        )
+        self.set_window(window)
+
+    def set_window(self, window: int) -> None:
+        """
+        Set the maximum number of batches in flight.
+
+        Args:
+            window: Batches in flight, between 1 and MAX_BATCH_WINDOW
+
+        Raises:
+            ValueError: If window is out of range
+        """
+        if not 1 <= window <= MAX_BATCH_WINDOW:
+            raise ValueError(
+                f"Batch window must be between 1 and {MAX_BATCH_WINDOW}, got {window}"
+            )
+        with self._cond:
+            self._window = window
+            self._cond.notify_all()
+
+    def submit(
+        self,
+        server_instance: Any,
+        batch: List[BatchedRPC],
+        on_done: Callable[[BatchExecutionResult], None],
+        priority: bool = False,
+    ) -> None:
+        """
+        Send a batch once a window slot is free, without waiting for results.
+
+        Args:
+            server_instance: The server instance to execute calls on
+            batch: List of batched RPCs to execute
+            on_done: Called with the result on a sender thread
+            priority: Send on the priority lane
+        """
+        batch, eliminated = BatchProcessor.optimize_batch(batch)
+        self._eliminated_calls += len(eliminated)
+        if not batch:
+            BatchProcessor.complete_eliminated(eliminated)
+            return
+        prepared = BatchProcessor.prepare_batch(batch)
+        footprint = _footprint(batch)
+
+        with self._cond:
+            while not self._can_send(priority, footprint):
+                self._cond.wait()
+            if self._restarting[priority]:
+                self._start_session(priority)
+            token = self._next_token
+            self._next_token += 1
+            self._inflight[token] = (priority, footprint)
+            order = (self._sessions[priority], self._next_seq[priority])
+            self._next_seq[priority] += 1
+            self._sent_batches[priority] += 1
+            # Encode in sequence order against the session the batch goes to
+            batch_calls = self._templates[priority].encode(prepared)
+
+        self._executor.submit(
+            self._send,
+            server_instance,
+            batch,
+            batch_calls,
+            eliminated,
+            priority,
+            order,
+            token,
+            on_done,
+        )
+
+    def _can_send(self, priority: bool, footprint: Footprint) -> bool:
+        """Check whether a batch may go out now; call with _cond held."""
+        # A priority batch may exceed a window full of bulk batches by one
+        window = self._window + 1 if priority else self._window
+        if len(self._inflight) >= window:
+            return False
+        if self._restarting[priority] and any(
+            lane == priority for lane, _ in self._inflight.values()
+        ):
+            return False
+        return not any(
+            lane != priority and _conflicts(inflight, *footprint)
+            for lane, inflight in self._inflight.values()
+        )
+
+    def _send(
+        self,
+        server_instance: Any,
+        batch: List[BatchedRPC],
+        batch_calls: List[Dict[str, Any]],
+        eliminated: List[BatchedRPC],
+        priority: bool,
+        order: Tuple[str, int],
+        token: int,
+        on_done: Callable[[BatchExecutionResult], None],
+    ) -> None:
+        try:
+            result = BatchProcessor.execute_batch(
+                server_instance,
+                batch,
+                batch_calls,
+                order=order,
+                eliminated=eliminated,
+            )
+            if result.lost:
+                # The server may never have seen this batch, so later batches
+                # of its session could wait for it or miss its templates
+                self._restart_session(priority, order[0])
+            on_done(result)
+        except Exception as e:
+            log.error(f"❌ Batch completion failed for client {self.client_id}: {e}")
+        finally:
+            with self._cond:
+                del self._inflight[token]
+                self._cond.notify_all()
+
+    def _restart_session(self, lane: bool, session: str) -> None:
+        """
+        Abandon a lane's session after one of its batches was lost.
+
+        The next batch of the lane waits for the lane to drain and then opens
+        a new session (see _start_session).
+
+        Args:
+            lane: Whether it is the priority lane
+            session: Session the lost batch was sent in
+        """
+        with self._cond:
+            if self._sessions[lane] != session or self._restarting[lane]:
+                # Another lost batch of the session already abandoned it
+                return
+            log.warning(
+                f"⚠️ Batch lost for client {self.client_id}, starting a new "
+                f"{'priority' if lane else 'bulk'} session"
             )
+            self._restarting[lane] = True
+            self._cond.notify_all()
+
+    def _start_session(self, lane: bool) -> None:
+        """Open a new session for a drained lane; call with _cond held."""
+        self._sessions[lane] = uuid.uuid4().hex
+        self._next_seq[lane] = 0
+        self._templates[lane].reset()
+        self._restarting[lane] = False
+
+    def wait_idle(self) -> None:
+        """Block until every submitted batch has completed."""
+        with self._cond:
+            while self._inflight:
+                self._cond.wait()
+
+    def get_stats(self) -> Dict[str, Any]:
+        """
+        Get statistics about the pipeline.
+
+        Returns:
+            Dictionary with the window size, batches in flight, batches sent
+            in total and on the priority lane, calls the batch optimizer
+            eliminated and op template statistics of both lanes combined
+        """
+        bulk, priority = (self._templates[lane].get_stats() for lane in (False, True))
+        with self._cond:
+            return {
+                "window": self._window,
+                "inflight_batches": len(self._inflight),
+                "sent_batches": self._sent_batches[False] + self._sent_batches[True],
+                "priority_batches": self._sent_batches[True],
+                "eliminated_calls": self._eliminated_calls,
+                "op_templates": {key: bulk[key] + priority[key] for key in bulk},
+            }
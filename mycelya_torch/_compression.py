@@ -0,0 +1,157 @@
+# Copyright (C) 2025 alyxya
+# SPDX-License-Identifier: AGPL-3.0-or-later
+
+"""
+Transfer compression for storage uploads and downloads.
+
+Payloads are compressed with LZ4 (fast) or zstd (better ratio) when the
+optional ``lz4``/``zstandard`` packages are installed. In ``"auto"`` mode a
+sample from the start of each payload decides whether compression pays off:
+masks, token IDs and zero-filled buffers compress well, random floats do not
+and are sent raw.
+
+Compressed payloads travel as a plain ``(codec, data)`` tuple so the server
+can decode them without importing mycelya_torch.
+"""
+
+from typing import Any, List, Optional, Tuple
+
+# Payloads smaller than this are never worth compressing
+MIN_COMPRESS_BYTES = 64 * 1024
+
+# Size of the prefix sampled to estimate compressibility
+SAMPLE_BYTES = 256 * 1024
+
+# Sampled compressed/raw ratio above which payloads are sent raw
+MAX_USEFUL_RATIO = 0.9
+
+# Sampled ratio at or below which zstd's better ratio outweighs LZ4's speed
+ZSTD_RATIO = 0.5
+
+ZSTD_LEVEL = 3
+
+_MODES = ("off", "auto", "lz4", "zstd")
+_mode = "auto"
+
+
+def _codec_available(codec: str) -> bool:
+    try:
+        if codec == "lz4":
+            import lz4.frame  # noqa: F401
+        elif codec == "zstd":
+            import zstandard  # noqa: F401
+        else:
+            return False
+    except ImportError:
+        return False
+    return True
+
+
+_available = {codec: _codec_available(codec) for codec in ("lz4", "zstd")}
+
+
+def set_transfer_compression(mode: str) -> None:
+    """
+    Set the compression mode for storage transfers.
+
+    Args:
+        mode: "off", "auto" (sample and pick a codec), "lz4" or "zstd"
+
+    Raises:
+        ValueError: If mode is unknown
+        RuntimeError: If the requested codec package is not installed
+    """
+    global _mode
+    if mode not in _MODES:
+        raise ValueError(
+            f"Unknown compression mode {mode!r}, expected one of {_MODES}"
+        )
+    if mode in _available and not _available[mode]:
+        raise RuntimeError(f"Compression codec {mode!r} is not installed")
+    _mode = mode
+
+
+def get_transfer_compression() -> str:
+    """Get the current compression mode for storage transfers."""
+    return _mode
+
+
+def accepted_codecs() -> List[str]:
+    """
+    Get the codecs this client can decode, in order of preference.
+
+    Returns:
+        Codec names to offer the server for downloads (empty if disabled)
+    """
+    if _mode == "off":
+        return []
+    if _mode in _available:
+        return [_mode]
+    return [codec for codec in ("lz4", "zstd") if _available[codec]]
+
+
+def compress(codec: str, data: Any) -> bytes:
+    """Compress a bytes-like object with the given codec."""
+    if codec == "lz4":
+        import lz4.frame
+
+        return lz4.frame.compress(data)
+    if codec == "zstd":
+        import zstandard
+
+        return zstandard.ZstdCompressor(level=ZSTD_LEVEL).compress(data)
+    raise ValueError(f"Unknown compression codec {codec!r}")
+
+
+def decompress(codec: str, data: Any) -> bytes:
+    """Decompress a bytes-like object produced by compress()."""
+    if codec == "lz4":
+        import lz4.frame
+
+        return lz4.frame.decompress(data)
+    if codec == "zstd":
+        import zstandard
+
+        return zstandard.ZstdDecompressor().decompress(data)
+    raise ValueError(f"Unknown compression codec {codec!r}")
+
+
+def choose_codec(data: memoryview, codecs: List[str]) -> Optional[str]:
+    """
+    Pick a codec for a payload by compressing a sample of it.
+
+    Args:
+        data: Payload bytes
+        codecs: Candidate codecs in order of preference
+
+    Returns:
+        Codec name, or None if the payload should be sent raw
+    """
+    if not codecs or data.nbytes < MIN_COMPRESS_BYTES:
+        return None
+    if len(codecs) == 1 and _mode != "auto":
+        return codecs[0]
+
+    sample = data[:SAMPLE_BYTES]
+    ratio = len(compress(codecs[0], sample)) / sample.nbytes
+    if ratio > MAX_USEFUL_RATIO:
+        return None
+    if ratio <= ZSTD_RATIO and "zstd" in codecs:
+        return "zstd"
+    return codecs[0]
+
+
+def decode_payload(payload: Any) -> Tuple[Any, Optional[str], int]:
+    """
+    Decode a payload that may have been compressed by the other side.
+
+    Args:
+        payload: Raw bytes or a (codec, data) tuple
+
+    Returns:
+        Tuple of (raw bytes, codec used or None, bytes received on the wire)
+    """
+    if isinstance(payload, tuple):
+        codec, data = payload
+        return decompress(codec, data), codec, len(data)
+    return payload, None, len(payload)
@@ -1,8 +1,11 @@
 # Copyright (C) 2025 alyxya
 # SPDX-License-Identifier: AGPL-3.0-or-later
 
+import itertools
+import threading
 from collections import defaultdict
-from typing import Any, Callable, Dict, List, Optional
+from concurrent.futures import Future
+from typing import Any, Callable, Dict, List, Optional, Set, Tuple
 
 import torch
 
@@ -46,14 +49,18 @@ class DeviceRegistry:
         # Current device tracking
         self._current_device: int = 0
 
-        # Stream management - no torch.Stream objects, only stream IDs
-        self._current_streams: Dict[int, int] = defaultdict(
-            lambda: 0
-        )  # device_idx -> current stream_id
+        # Stream management - no torch.Stream objects, only stream IDs.
+        # Current streams are per thread like CUDA's, so work a background
+        # thread queues on its own stream keeps that stream's priority.
+        self._local = threading.local()
         self._stream_registry: Dict[int, List[int]] = defaultdict(
             lambda: [0]
         )  # device_idx -> list of stream_ids
 
+        # (device_idx, stream_id) of streams created with a high priority
+        # (below 0, as in CUDA); RPCs queued on them use the priority lane
+        self._priority_streams: Set[Tuple[int, int]] = set()
+
     def get_device_count(self) -> int:
         """Return number of devices"""
         # Get actual device count from the device registry
@@ -92,12 +99,25 @@ class DeviceRegistry:
         return old_device_idx
 
     # Stream management methods
+    def _current_streams(self) -> Dict[int, int]:
+        """Get the calling thread's device_idx -> current stream_id map."""
+        streams = getattr(self._local, "streams", None)
+        if streams is None:
+            streams = self._local.streams = {}
+        return streams
+
     def get_stream(self, device_idx: int) -> int:
         """Get current stream ID for device"""
-        current_stream_id = self._current_streams[
-            device_idx
-        ]  # defaultdict returns 0 if not set
-        return current_stream_id
+        return self._current_streams().get(device_idx, 0)
+
+    def has_priority_streams(self) -> bool:
+        """Check whether any high-priority stream was ever created"""
+        return bool(self._priority_streams)
+
+    def is_priority_stream(self, device_idx: int) -> bool:
+        """Check whether the current stream for device is high priority"""
+        stream_id = self._current_streams().get(device_idx, 0)
+        return (device_idx, stream_id) in self._priority_streams
 
     def get_new_stream(self, device_idx: int, priority: int = 0) -> int:
         """Create new stream ID for device and add to registry"""
@@ -111,21 +131,22 @@ class DeviceRegistry:
 
         # Add to registry
         registry.append(new_stream_id)
+        if priority < 0:
+            self._priority_streams.add((device_idx, new_stream_id))
 
         # Set as current stream for this device
-        self._current_streams[device_idx] = new_stream_id
+        self._current_streams()[device_idx] = new_stream_id
 
         return new_stream_id
 
     def exchange_stream(self, stream_id: int, device_idx: int) -> int:
         """Exchange current stream ID and return previous stream ID"""
         # Get the previous current stream ID
-        previous_stream_id = self._current_streams[
-            device_idx
-        ]  # defaultdict returns 0 if not set
+        current_streams = self._current_streams()
+        previous_stream_id = current_streams.get(device_idx, 0)
 
         # Set the new stream as current
-        self._current_streams[device_idx] = stream_id
+        current_streams[device_idx] = stream_id
 
         # Make sure this stream ID is in our registry
         registry = self._stream_registry[
@@ -144,6 +165,10 @@ class Driver:
 
     def __init__(self) -> None:
         self.registry_obj = DeviceRegistry()
+        # event id -> non_blocking copies outstanding when it was recorded
+        self._events: Dict[int, List[Future]] = {}
+        # next() on a count is atomic under the GIL, so threads never share an id
+        self._event_ids = itertools.count(1)
 
     def exec(self, cmd: str, *args: Any) -> Any:
         """Execute a command using the registry pattern"""
@@ -226,48 +251,56 @@ class Driver:
     def exchange_stream(self, stream_id: int, device_idx: int) -> int:
         return self.registry_obj.exchange_stream(stream_id, device_idx)
 
-    # Event operations (placeholders for now)
+    # Event operations - events capture the non_blocking copies outstanding
+    # on their device when recorded, which is all the asynchrony the host sees
     @register(registry)
     def create_event(self, device_idx: int, flag: int) -> int:
-        """Create event - placeholder implementation"""
-        return 1
+        event_id = next(self._event_ids)
+        self._events[event_id] = []
+        return event_id
 
     @register(registry)
     def destroy_event(self, event: int, device_idx: int) -> None:
-        """Destroy event - placeholder implementation"""
-        pass
+        self._events.pop(event, None)
 
     @register(registry)
     def record(
         self, event: int, stream: torch.Stream, device_idx: int, flag: int
     ) -> None:
-        """Record event - placeholder implementation"""
-        pass
+        from ._remote_orchestrator import remote_orchestrator
+
+        self._events[event] = remote_orchestrator.pending_copies(device_idx)
 
     @register(registry)
     def block(self, event: int, stream: torch.Stream) -> None:
-        """Block on event - placeholder implementation"""
+        """Block on event - remote streams execute in submission order"""
         pass
 
     @register(registry)
     def query_event(self, event: int) -> bool:
-        """Query event - placeholder implementation"""
-        return True
+        return all(future.done() for future in self._events.get(event, []))
 
     @register(registry)
     def synchronize_event(self, event: int) -> None:
-        """Synchronize event - placeholder implementation"""
-        pass
+        pending = self._events.get(event, [])
+        if any(not future.done() for future in pending):
+            from ._remote_orchestrator import remote_orchestrator
+
+            remote_orchestrator.wake_batch_thread_for_blocking_rpc()
+        for future in pending:
+            future.result()
 
     @register(registry)
     def query_stream(self, stream: torch.Stream) -> bool:
-        """Query stream - placeholder implementation"""
-        return True
+        from ._remote_orchestrator import remote_orchestrator
+
+        return not remote_orchestrator.pending_copies(stream.device_index)
 
     @register(registry)
     def synchronize_stream(self, stream: torch.Stream) -> None:
-        """Synchronize stream - placeholder implementation"""
-        pass
+        from ._remote_orchestrator import remote_orchestrator
+
+        remote_orchestrator.synchronize(stream.device_index)
 
     @register(registry)
     def record_data_ptr_on_stream(self, data_ptr: int, stream: torch.Stream) -> None:
@@ -0,0 +1,166 @@
+# Copyright (C) 2025 alyxya
+# SPDX-License-Identifier: AGPL-3.0-or-later
+
+"""
+Flush policy for the RPC batcher.
+
+A client's queued RPCs are sent as one batch as soon as any trigger fires:
+
+- blocking: a caller is waiting on a result (remote call, synchronize, event)
+- calls: the number of pending calls reached max_calls
+- bytes: the payload bytes of pending calls reached max_bytes
+- age: the oldest pending call has waited max_age seconds
+
+The age deadline adapts to the observed batch round-trip time. Batching only
+pays off while the time spent waiting is small next to the round trip it
+saves, so the deadline tracks a fraction of the smoothed RTT: fast local
+servers flush almost immediately, slow links accumulate larger batches.
+Explicit overrides pin a threshold regardless of the RTT.
+"""
+
+import threading
+from typing import Any, Dict, Optional
+
+FLUSH_REASONS = ("blocking", "calls", "bytes", "age")
+
+# Defaults for the count and byte triggers
+DEFAULT_MAX_CALLS = 512
+DEFAULT_MAX_BYTES = 32 * 1024 * 1024
+
+# The adaptive age deadline is AGE_RTT_FRACTION of the smoothed RTT, clamped
+# to [MIN_MAX_AGE, MAX_MAX_AGE] seconds
+AGE_RTT_FRACTION = 0.25
+MIN_MAX_AGE = 0.001
+MAX_MAX_AGE = 0.1
+
+# Weight of the newest sample in the RTT moving average
+RTT_SMOOTHING = 0.2
+
+
+class FlushPolicy:
+    """Decides when a client's pending RPCs should be sent."""
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._overrides: Dict[str, Optional[float]] = {
+            "max_calls": None,
+            "max_bytes": None,
+            "max_age": None,
+        }
+        self._rtt: Optional[float] = None
+        self._flush_counts = {reason: 0 for reason in FLUSH_REASONS}
+
+    @property
+    def max_calls(self) -> int:
+        override = self._overrides["max_calls"]
+        return DEFAULT_MAX_CALLS if override is None else int(override)
+
+    @property
+    def max_bytes(self) -> int:
+        override = self._overrides["max_bytes"]
+        return DEFAULT_MAX_BYTES if override is None else int(override)
+
+    @property
+    def max_age(self) -> float:
+        override = self._overrides["max_age"]
+        if override is not None:
+            return override
+        if self._rtt is None:
+            return MAX_MAX_AGE
+        return min(MAX_MAX_AGE, max(MIN_MAX_AGE, AGE_RTT_FRACTION * self._rtt))
+
+    def configure(
+        self,
+        max_calls: Optional[int] = None,
+        max_bytes: Optional[int] = None,
+        max_age: Optional[float] = None,
+    ) -> None:
+        """
+        Override flush thresholds; None restores the default or adaptive value.
+
+        Args:
+            max_calls: Pending call count that triggers a flush
+            max_bytes: Pending payload bytes that trigger a flush
+            max_age: Seconds the oldest pending call may wait
+
+        Raises:
+            ValueError: If a threshold is not positive
+        """
+        values = {"max_calls": max_calls, "max_bytes": max_bytes, "max_age": max_age}
+        for name, value in values.items():
+            if value is not None and value <= 0:
+                raise ValueError(f"{name} must be positive, got {value}")
+        with self._lock:
+            self._overrides.update(values)
+
+    def observe_rtt(self, seconds: float) -> None:
+        """Feed the round-trip time of a sent batch into the moving average."""
+        with self._lock:
+            if self._rtt is None:
+                self._rtt = seconds
+            else:
+                self._rtt += RTT_SMOOTHING * (seconds - self._rtt)
+
+    def check(
+        self, pending_calls: int, pending_bytes: int, age: float, blocking: bool
+    ) -> Optional[str]:
+        """
+        Get the reason to flush now, if any.
+
+        Args:
+            pending_calls: Number of queued calls
+            pending_bytes: Payload bytes of queued calls
+            age: Seconds the oldest queued call has waited
+            blocking: Whether a caller is waiting on the queue
+
+        Returns:
+            One of FLUSH_REASONS, or None to keep accumulating
+        """
+        if pending_calls == 0:
+            return None
+        if blocking:
+            return "blocking"
+        if pending_calls >= self.max_calls:
+            return "calls"
+        if pending_bytes >= self.max_bytes:
+            return "bytes"
+        if age >= self.max_age:
+            return "age"
+        return None
+
+    def time_until_due(self, pending_calls: int, age: float) -> Optional[float]:
+        """
+        Get the seconds until the age trigger fires.
+
+        Args:
+            pending_calls: Number of queued calls
+            age: Seconds the oldest queued call has waited
+
+        Returns:
+            Seconds to wait, or None if nothing is pending
+        """
+        if pending_calls == 0:
+            return None
+        return max(0.0, self.max_age - age)
+
+    def record_flush(self, reason: str) -> None:
+        """Count a flush under the trigger that caused it."""
+        with self._lock:
+            self._flush_counts[reason] += 1
+
+    def get_stats(self) -> Dict[str, Any]:
+        """
+        Get the current thresholds and why past flushes happened.
+
+        Returns:
+            Dictionary with effective thresholds, the smoothed RTT in seconds
+            (None before the first batch) and flush counts per reason
+        """
+        with self._lock:
+            return {
+                "max_calls": self.max_calls,
+                "max_bytes": self.max_bytes,
+                "max_age": self.max_age,
+                "rtt": self._rtt,
+                "flushes": dict(self._flush_counts),
+            }
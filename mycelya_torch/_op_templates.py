@@ -0,0 +1,176 @@
+# Copyright (C) 2025 alyxya
+# SPDX-License-Identifier: AGPL-3.0-or-later
+
+"""
+Op templates for batched execute_aten_operation calls.
+
+Autoregressive decoding issues the same sequence of ops every step: op names,
+tensor shapes, strides, dtypes and kwargs repeat and only storage IDs and
+scalars change. Each pipeline session keeps a template table mirrored by the
+server. The first call with a given structure defines a template, sending
+its skeleton once with every storage ID and scalar replaced by a slot marker.
+Later calls with the same structure send only the template ID and the slot
+values, and the server refills the skeleton.
+
+Batches of a session execute strictly in order, so a template defined in one
+batch can be referenced by every batch sent after it.
+"""
+
+import threading
+from typing import Any, Dict, List, Optional, Tuple
+
+import torch
+
+# Slot marker in template skeletons; must match TEMPLATE_SLOT in modal_app.py
+TEMPLATE_SLOT = "__SLOT__"
+
+# Templates defined per session; calls with new structures are sent in full
+# once the table is full
+MAX_TEMPLATES = 4096
+
+# Non-scalar leaves whose repr identifies their value, so a skeleton's repr
+# can key the table. Calls with other leaves are never templated.
+_LEAF_TYPES = (
+    str,
+    bool,
+    int,
+    float,
+    type(None),
+    torch.dtype,
+    torch.device,
+    torch.layout,
+    torch.memory_format,
+)
+
+
+class _Untemplatable(Exception):
+    pass
+
+
+def _split(value: Any, values: List[Any], slot_scalars: bool) -> Any:
+    """Replace storage IDs and scalars with slots, collecting their values."""
+    kind = type(value)
+    if slot_scalars and kind in (int, float, complex):
+        values.append(value)
+        return TEMPLATE_SLOT
+    if kind in (list, tuple):
+        return kind(_split(item, values, slot_scalars) for item in value)
+    if kind is dict:
+        return {key: _split(item, values, slot_scalars) for key, item in value.items()}
+    if isinstance(value, _LEAF_TYPES) and not (kind is str and value == TEMPLATE_SLOT):
+        return value
+    raise _Untemplatable
+
+
+def split_aten_call(args: tuple) -> Optional[Tuple[tuple, List[Any]]]:
+    """
+    Split execute_aten_operation arguments into a skeleton and slot values.
+
+    Args:
+        args: (op_name, input_tensor_metadata, output_storage_ids, args, kwargs)
+
+    Returns:
+        Tuple of (skeleton, slot values in skeleton order), or None if the
+        call cannot be templated
+    """
+    op_name, input_tensor_metadata, output_storage_ids, op_args, op_kwargs = args
+    values: List[Any] = []
+    try:
+        metadata = []
+        for tensor_metadata in input_tensor_metadata:
+            entry = {}
+            for key, item in tensor_metadata.items():
+                if key == "storage_id":
+                    values.append(item)
+                    entry[key] = TEMPLATE_SLOT
+                else:
+                    entry[key] = _split(item, values, False)
+            metadata.append(entry)
+        skeleton = (
+            op_name,
+            metadata,
+            _split(list(output_storage_ids), values, True),
+            _split(op_args, values, True),
+            _split(op_kwargs, values, True),
+        )
+    except _Untemplatable:
+        return None
+    return skeleton, values
+
+
+class OpTemplateEncoder:
+    """Client half of a pipeline session's op template table."""
+
+    def __init__(self, max_templates: int = MAX_TEMPLATES):
+        self._max_templates = max_templates
+        self._ids: Dict[str, int] = {}
+        self._next_id = 0
+        self._lock = threading.Lock()
+        self._templated_calls = 0
+        self._full_calls = 0
+
+    def encode(self, batch_calls: List[Dict[str, Any]]) -> List[Dict[str, Any]]:
+        """
+        Replace repeated execute_aten_operation calls with template references.
+
+        Args:
+            batch_calls: Call dictionaries from BatchProcessor.prepare_batch
+
+        Returns:
+            Call dictionaries to send, in the same order
+        """
+        encoded = []
+        for call in batch_calls:
+            if call["method_name"] == "execute_aten_operation":
+                call = self._encode_call(call)
+            encoded.append(call)
+        return encoded
+
+    def _encode_call(self, call: Dict[str, Any]) -> Dict[str, Any]:
+        split = split_aten_call(call["args"])
+        if split is None:
+            self._full_calls += 1
+            return call
+        skeleton, values = split
+        key = repr(skeleton)
+
+        with self._lock:
+            template_id = self._ids.get(key)
+            define = template_id is None
+            if define:
+                if len(self._ids) >= self._max_templates:
+                    self._full_calls += 1
+                    return call
+                template_id = self._ids[key] = self._next_id
+                self._next_id += 1
+            self._templated_calls += 1
+
+        encoded = {**call, "args": values, "template": template_id}
+        if define:
+            encoded["template_def"] = skeleton
+        return encoded
+
+    def reset(self) -> None:
+        """
+        Forget all templates when the server starts a new, empty table.
+
+        Batches encoded before the reset reference the old table and must
+        only be sent in the session they were encoded for.
+        """
+        with self._lock:
+            self._ids.clear()
+
+    def get_stats(self) -> Dict[str, Any]:
+        """
+        Get statistics about the template table.
+
+        Returns:
+            Dictionary with the number of templates and of aten calls sent
+            as template references or in full
+        """
+        with self._lock:
+            return {
+                "templates": len(self._ids),
+                "templated_calls": self._templated_calls,
+                "full_calls": self._full_calls,
+            }
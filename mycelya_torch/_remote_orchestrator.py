@@ -11,14 +11,16 @@ Currently supports Modal as the first provider implementation.
 
 import atexit
 import threading
-from typing import Any, Dict, List, Optional, Set, Tuple
+from concurrent.futures import Future
+from typing import Any, Dict, List, Optional, Tuple
 
 import torch
 
-from ._batching import BatchProcessor
+from ._batching import BatchExecutionResult, exempt_from_backpressure
 from ._logging import get_logger
 from ._storage import get_machine_for_storage
 from ._tensor_utils import RemoteTensorMetadata
+from ._wire_dtype import clear_storage_wire_dtype
 from .backends.client_interface import ClientInterface
 from .device import RemoteMachine
 
@@ -29,106 +31,146 @@ log = get_logger(__name__)
 # Custom exceptions removed as they were not used elsewhere in the codebase
 
 
-class RemoteOrchestrator:
-    """Orchestrates remote execution of aten operations across remote machines.
-
-    This class coordinates operation execution between local tensors and remote
-    machines, handling tensor transfers, device communication, and distributed
-    execution flow. Currently supports Modal as the primary provider.
+class ClientBatchSender:
+    """Background thread sending one client's RPC batches.
 
-    Also manages background thread for batching RPCs to improve performance.
+    Each client gets its own sender with its own wakeup, so a slow machine
+    only delays its own batches and multi-machine jobs scale without
+    head-of-line blocking.
     """
 
-    def __init__(self):
-        # Simple utility-based architecture - no service objects needed
+    def __init__(self, client: ClientInterface, idle_interval: float):
+        """
+        Initialize the sender for a client.
 
-        # RPC Batching System
-        self._batch_clients: Set[ClientInterface] = set()
-        self._batch_lock = threading.RLock()
-        self._batch_thread: Optional[threading.Thread] = None
-        self._batch_shutdown = threading.Event()
-        self._batch_wakeup = threading.Event()  # Wake up thread immediately for blocking calls
-        self._batch_interval = 0.1  # Process batches every 100ms
+        Args:
+            client: Client whose queue this sender drains
+            idle_interval: Longest sleep while no flush is due, in seconds
+        """
+        self.client = client
+        self._idle_interval = idle_interval
+        self._shutdown = threading.Event()
+        self._wakeup = threading.Event()  # Re-check flush triggers
+        self._flush_requested = threading.Event()  # Flush right away
+        self._wakeups = 0
+        self._thread = threading.Thread(
+            target=self._loop,
+            name=f"RPCBatchProcessor-{client.machine_id}",
+            daemon=True,
+        )
 
-        # Start background thread for batch processing
-        self._start_batch_thread()
+    def start(self) -> None:
+        """Start the sender thread."""
+        self._thread.start()
+        log.info(f"🧵 Started RPC batch sender for {self.client.machine_id}")
+
+    def stop(self, timeout: float = 2.0) -> None:
+        """Stop the sender thread, waiting up to timeout seconds."""
+        self._shutdown.set()
+        self._wakeup.set()
+        if self._thread.is_alive() and self._thread is not threading.current_thread():
+            self._thread.join(timeout=timeout)
+            if self._thread.is_alive():
+                log.warning(
+                    f"⚠️ Batch sender for {self.client.machine_id} "
+                    "did not shutdown cleanly"
+                )
+
+    def is_alive(self) -> bool:
+        return self._thread.is_alive()
+
+    def wake(self, flush: bool = False) -> None:
+        """
+        Wake the sender to re-check its client's flush triggers.
 
-        # Register cleanup on exit
-        atexit.register(self._cleanup_batch_thread)
+        Args:
+            flush: Send everything pending regardless of thresholds
+        """
+        if flush:
+            self._flush_requested.set()
+        self._wakeup.set()
+
+    def get_stats(self) -> Dict[str, Any]:
+        """Get the sender's thread state and wakeup count."""
+        return {"thread_alive": self.is_alive(), "wakeups": self._wakeups}
+
+    def _loop(self) -> None:
+        """Main loop of the sender thread."""
+        # The sender drains the queue, so it must never wait for room in it
+        exempt_from_backpressure()
+        while not self._shutdown.is_set():
+            try:
+                flush = self._flush_requested.is_set()
+                self._flush_requested.clear()
 
-    def _get_device_client(self, machine: "RemoteMachine"):
-        """Get the active client for a specific machine."""
-        return machine._client
+                timeout = self._idle_interval
+                due = self._process_batch(flush)
+                if due is not None:
+                    timeout = min(timeout, due)
 
-    # Background thread management for RPC batching
-    def _start_batch_thread(self) -> None:
-        """Start the background thread for processing RPC batches."""
-        if self._batch_thread is None or not self._batch_thread.is_alive():
-            self._batch_shutdown.clear()
-            self._batch_thread = threading.Thread(
-                target=self._batch_processing_loop,
-                name="RPCBatchProcessor",
-                daemon=True,
-            )
-            self._batch_thread.start()
-            log.info("🧵 Started RPC batch processing thread")
-
-    def _cleanup_batch_thread(self) -> None:
-        """Clean up the background batch processing thread."""
-        if self._batch_thread and self._batch_thread.is_alive():
-            log.info("🛑 Shutting down RPC batch processing thread")
-            self._batch_shutdown.set()
-            self._batch_thread.join(timeout=2.0)
-            if self._batch_thread.is_alive():
-                log.warning("⚠️ Batch processing thread did not shutdown cleanly")
-
-    def _batch_processing_loop(self) -> None:
-        """Main loop for the background batch processing thread."""
-        log.info("🚀 RPC batch processing loop started")
-
-        while not self._batch_shutdown.is_set():
-            try:
-                # Process batches for all registered clients
-                with self._batch_lock:
-                    clients_to_process = list(self._batch_clients)
-
-                for client in clients_to_process:
-                    try:
-                        self._process_client_batch(client)
-                    except Exception as e:
-                        log.error(f"❌ Error processing batch for client {client}: {e}")
-
-                # Wait for next batch interval OR immediate wakeup for blocking calls
-                woken_early = self._batch_wakeup.wait(self._batch_interval)
-                if woken_early:
-                    # Clear the event for next time and process immediately
-                    self._batch_wakeup.clear()
-                    log.debug("🚀 Background thread woken early for blocking RPC")
+                # Sleep until the age deadline OR an early wakeup for blocking
+                # calls and batches that start or fill up
+                if self._wakeup.wait(timeout):
+                    self._wakeup.clear()
+                    self._wakeups += 1
 
             except Exception as e:
-                log.error(f"❌ Error in batch processing loop: {e}")
-
-        log.info("🏁 RPC batch processing loop terminated")
+                log.error(f"❌ Error processing batch for client {self.client}: {e}")
 
-    def _process_client_batch(self, client: ClientInterface) -> None:
-        """Process a batch of RPCs for a specific client."""
-        if not hasattr(client, "_batch_queue"):
-            return
+        log.info(f"🏁 RPC batch sender for {self.client.machine_id} terminated")
 
-        batch = client._batch_queue.get_batch()
-        if not batch:
-            return
+    def _process_batch(self, flush: bool) -> Optional[float]:
+        """
+        Send the client's pending RPCs if its flush policy says so.
 
-        try:
-            # Execute the batch
-            result = BatchProcessor.execute_batch(client._server_instance, batch)
+        Args:
+            flush: Flush regardless of thresholds (someone is waiting)
 
+        Returns:
+            Seconds until the client's age deadline if calls are still
+            pending, None otherwise
+        """
+        client = self.client
+        policy = client._flush_policy
+        calls, nbytes, age, blocking = client._pending_state()
+        reason = policy.check(calls, nbytes, age, blocking or flush)
+        if reason is None:
+            return policy.time_until_due(calls, age)
+
+        # Send uploads still waiting in the pack buffer with this batch
+        client._flush_packed_uploads()
+
+        # Priority calls and blocking reads only need the calls they depend on
+        # and go out on the priority lane; explicit flushes (synchronize,
+        # events) still send everything
+        if reason == "blocking" and not flush:
+            batch = client._batch_queue.get_dependent_batch()
+            priority = any(call.priority for call in batch)
+        else:
+            batch = client._batch_queue.get_batch()
+            priority = False
+        if not batch:
+            return None
+        policy.record_flush(reason)
+
+        def _on_done(result: BatchExecutionResult) -> None:
+            policy.observe_rtt(result.execution_time)
+            if result.lost:
+                # The lane restarts its session; no delta upload sent before
+                # this point is known to have been applied
+                client._chunk_hashes.clear()
             log.debug(
                 f"📊 Batch processed for {client}: "
                 f"{result.success_count} success, {result.error_count} errors, "
                 f"{result.execution_time:.3f}s"
             )
 
+        try:
+            # Send the batch; its futures resolve when its results arrive
+            client._batch_pipeline.submit(
+                client._server_instance, batch, _on_done, priority=priority
+            )
+
         except Exception as e:
             log.error(f"❌ Batch execution failed for client {client}: {e}")
 
@@ -137,42 +179,168 @@ class RemoteOrchestrator:
                 if call.future and not call.future.done():
                     call.future.set_exception(e)
 
+        # Calls held back by a dependency flush keep their age deadline; a
+        # blocking one among them is sent on the next pass
+        calls, _, age, blocking = client._batch_queue.pending()
+        return 0.0 if blocking else policy.time_until_due(calls, age)
+
+
+class RemoteOrchestrator:
+    """Orchestrates remote execution of aten operations across remote machines.
+
+    This class coordinates operation execution between local tensors and remote
+    machines, handling tensor transfers, device communication, and distributed
+    execution flow. Currently supports Modal as the primary provider.
+
+    Also manages background thread for batching RPCs to improve performance.
+    """
+
+    def __init__(self):
+        # Simple utility-based architecture - no service objects needed
+
+        # RPC Batching System: one sender thread per registered client
+        self._batch_senders: Dict[ClientInterface, ClientBatchSender] = {}
+        self._batch_lock = threading.RLock()
+        self._batch_interval = 0.1  # Longest sleep while no flush is due
+
+        # Outstanding non_blocking copies per device index, awaited by
+        # synchronize() and snapshotted by recorded events
+        self._pending_copies: Dict[int, List[Future]] = {}
+        self._pending_copies_lock = threading.Lock()
+
+        # Register cleanup on exit
+        atexit.register(self._cleanup_batch_senders)
+
+    def _get_device_client(self, machine: "RemoteMachine"):
+        """Get the active client for a specific machine."""
+        return machine._client
+
+    # Background sender management for RPC batching
+    def _cleanup_batch_senders(self) -> None:
+        """Stop every client's batch sender thread."""
+        with self._batch_lock:
+            senders = list(self._batch_senders.values())
+            self._batch_senders.clear()
+        if senders:
+            log.info("🛑 Shutting down RPC batch senders")
+        for sender in senders:
+            sender.stop()
+
     def register_client_for_batching(self, client: ClientInterface) -> None:
-        """Register a client for RPC batching."""
+        """Register a client for RPC batching and start its sender."""
         with self._batch_lock:
-            self._batch_clients.add(client)
+            if client in self._batch_senders:
+                return
+            sender = ClientBatchSender(client, self._batch_interval)
+            self._batch_senders[client] = sender
+            sender.start()
             log.info(f"📝 Registered client for batching: {client}")
 
     def unregister_client_for_batching(self, client: ClientInterface) -> None:
-        """Unregister a client from RPC batching."""
+        """Unregister a client from RPC batching and stop its sender."""
         with self._batch_lock:
-            self._batch_clients.discard(client)
+            sender = self._batch_senders.pop(client, None)
+        if sender is not None:
+            sender.stop()
             log.info(f"🗑️ Unregistered client from batching: {client}")
 
-    def wake_batch_thread_for_blocking_rpc(self) -> None:
-        """Wake up the background thread immediately for processing blocking RPCs."""
-        if self._batch_thread and self._batch_thread.is_alive():
-            self._batch_wakeup.set()
-            log.debug("💨 Signaled batch thread to wake up for blocking RPC")
+    def _senders_for(
+        self, client: Optional[ClientInterface]
+    ) -> List[ClientBatchSender]:
+        with self._batch_lock:
+            if client is None:
+                return list(self._batch_senders.values())
+            sender = self._batch_senders.get(client)
+            return [] if sender is None else [sender]
+
+    def wake_batch_thread_for_blocking_rpc(
+        self, client: Optional[ClientInterface] = None
+    ) -> None:
+        """Have batch senders send everything pending right away.
+
+        Args:
+            client: Client someone is waiting on, or None for every client
+        """
+        for sender in self._senders_for(client):
+            sender.wake(flush=True)
+        log.debug("💨 Signaled batch senders to flush for blocking RPC")
+
+    def wake_batch_thread(self, client: Optional[ClientInterface] = None) -> None:
+        """Have batch senders re-check their flush triggers.
+
+        Args:
+            client: Client whose queue changed, or None for every client
+        """
+        for sender in self._senders_for(client):
+            sender.wake()
+
+    def track_async_copy(self, device_index: int, future: Future) -> None:
+        """Track a non_blocking copy so device synchronization can wait on it.
+
+        Args:
+            device_index: Index of the remote device the copy targets
+            future: Future resolved when the copy completes
+        """
+        with self._pending_copies_lock:
+            pending = self._pending_copies.setdefault(device_index, [])
+            # Prune completed copies so the list stays bounded
+            pending[:] = [f for f in pending if not f.done()]
+            pending.append(future)
+
+    def pending_copies(self, device_index: Optional[int] = None) -> List[Future]:
+        """Get the outstanding non_blocking copies.
+
+        Args:
+            device_index: Device index to filter by, or None for all devices
+
+        Returns:
+            List of futures for copies that have not completed yet
+        """
+        with self._pending_copies_lock:
+            if device_index is None:
+                futures = [f for fs in self._pending_copies.values() for f in fs]
+            else:
+                futures = list(self._pending_copies.get(device_index, []))
+        return [f for f in futures if not f.done()]
+
+    def synchronize(self, device_index: Optional[int] = None) -> None:
+        """Block until all non_blocking copies for a device have completed.
+
+        Args:
+            device_index: Device index to synchronize, or None for all devices
+
+        Raises:
+            Exception: Re-raises the first error from a failed copy
+        """
+        pending = self.pending_copies(device_index)
+        if pending:
+            self.wake_batch_thread_for_blocking_rpc()
+        for future in pending:
+            future.result()
+
+        with self._pending_copies_lock:
+            for index, futures in self._pending_copies.items():
+                if device_index is None or index == device_index:
+                    futures[:] = [f for f in futures if not f.done()]
 
     def get_batch_stats(self) -> Dict[str, Any]:
         """Get statistics about RPC batching across all clients."""
         with self._batch_lock:
-            stats = {
-                "registered_clients": len(self._batch_clients),
-                "batch_interval": self._batch_interval,
-                "thread_alive": self._batch_thread.is_alive()
-                if self._batch_thread
-                else False,
-                "clients": [],
-            }
-
-            for client in self._batch_clients:
-                if hasattr(client, "_batch_queue"):
-                    client_stats = client._batch_queue.get_stats()
-                    stats["clients"].append(client_stats)
-
-            return stats
+            senders = dict(self._batch_senders)
+
+        stats = {
+            "registered_clients": len(senders),
+            "batch_interval": self._batch_interval,
+            "thread_alive": all(sender.is_alive() for sender in senders.values()),
+            "clients": [],
+        }
+
+        for client, sender in senders.items():
+            client_stats = client.get_batch_stats()
+            client_stats["sender"] = sender.get_stats()
+            stats["clients"].append(client_stats)
+
+        return stats
 
     def _get_client_for_storage(self, storage_id: int) -> ClientInterface:
         """Get the client for a specific storage ID with validation.
@@ -289,7 +457,8 @@ class RemoteOrchestrator:
         target_stride: List[int],
         target_storage_offset: int,
         target_dtype: str,
-    ) -> None:
+        non_blocking: bool = False,
+    ) -> Optional[Future]:
         """Update existing storage with storage tensor data.
 
         Args:
@@ -303,12 +472,16 @@ class RemoteOrchestrator:
             target_stride: Stride of the target view in storage
             target_storage_offset: Storage offset of the target view in storage
             target_dtype: Data type of the target view in storage
+            non_blocking: If True, return without waiting for the source to be staged
+
+        Returns:
+            Future resolved once the write is applied if non_blocking, None otherwise
 
         Raises:
             RuntimeError: If storage or client not available
         """
         client = self._get_client_for_storage(storage_id)
-        client.update_storage(
+        future = client.update_storage(
             storage_id,
             storage_tensor,
             source_shape,
@@ -319,10 +492,12 @@ class RemoteOrchestrator:
             target_stride,
             target_storage_offset,
             target_dtype,
+            non_blocking=non_blocking,
         )
 
         # Note: Cache invalidation now happens at queue time in batching system
         log.info(f"✅ ORCHESTRATOR: Updated storage {storage_id}")
+        return future
 
     def get_storage_tensor(
         self,
@@ -331,6 +506,7 @@ class RemoteOrchestrator:
         stride: List[int],
         storage_offset: int,
         dtype: str,
+        storage_nbytes: Optional[int] = None,
     ) -> "torch.Tensor":
         """Get storage data as a tensor with specified view parameters.
 
@@ -343,6 +519,8 @@ class RemoteOrchestrator:
             stride: Tensor stride for view
             storage_offset: Storage offset for view
             dtype: Tensor data type
+            storage_nbytes: Size of the whole storage, used to decide between
+                fetching only the view and fetching (and caching) the storage
 
         Returns:
             CPU tensor reconstructed from storage with specified view
@@ -352,11 +530,41 @@ class RemoteOrchestrator:
         """
         client = self._get_client_for_storage(storage_id)
         result = client.get_storage_tensor(
-            storage_id, shape, stride, storage_offset, dtype
+            storage_id, shape, stride, storage_offset, dtype, storage_nbytes
         )
         log.info(f"✅ ORCHESTRATOR: Retrieved tensor for storage {storage_id}")
         return result
 
+    def get_storage_tensor_async(
+        self,
+        storage_id: int,
+        shape: List[int],
+        stride: List[int],
+        storage_offset: int,
+        dtype: str,
+    ) -> Future:
+        """Get storage data as a tensor without blocking the caller.
+
+        Args:
+            storage_id: The storage ID to retrieve
+            shape: Tensor shape for view
+            stride: Tensor stride for view
+            storage_offset: Storage offset for view
+            dtype: Tensor data type
+
+        Returns:
+            Future resolving to a CPU tensor with the specified view
+
+        Raises:
+            RuntimeError: If storage or client not available
+        """
+        client = self._get_client_for_storage(storage_id)
+        future = client.get_storage_tensor_async(
+            storage_id, shape, stride, storage_offset, dtype
+        )
+        log.info(f"✅ ORCHESTRATOR: Queued async download for storage {storage_id}")
+        return future
+
     def resize_storage(self, storage_id: int, nbytes: int) -> None:
         """Resize storage to accommodate new byte size.
 
@@ -384,6 +592,7 @@ class RemoteOrchestrator:
         """
         client = self._get_client_for_storage(storage_id)
         client.remove_storage(storage_id)
+        clear_storage_wire_dtype(storage_id)
 
         # Note: Cache invalidation now happens at queue time in batching system
         log.info(f"✅ ORCHESTRATOR: Removed storage {storage_id}")
@@ -396,6 +605,8 @@ class RemoteOrchestrator:
         args: Tuple[Any, ...],
         kwargs: Dict[str, Any],
         return_metadata: bool = False,
+        rng_state: Optional[Dict[str, int]] = None,
+        mutated_storage_ids: Optional[List[int]] = None,
     ) -> Optional[List[Dict[str, Any]]]:
         """Execute remote operation with pure metadata (early conversion boundary).
 
@@ -410,6 +621,9 @@ class RemoteOrchestrator:
             args: Processed args with tensor placeholders
             kwargs: Processed kwargs with tensor placeholders
             return_metadata: If True, return output tensor metadata instead of None
+            rng_state: Philox seed/offset reserved for random operations
+            mutated_storage_ids: Storage IDs of inputs the op writes in place
+                without returning them
 
         Returns:
             None for normal operations, or List[Dict] of output tensor metadata if return_metadata=True
@@ -458,6 +672,8 @@ class RemoteOrchestrator:
             args,
             kwargs,
             return_metadata,
+            rng_state,
+            mutated_storage_ids,
         )
 
         # Note: With batching, cache invalidation for aten operations happens at queue time
@@ -501,12 +717,14 @@ class RemoteOrchestrator:
             stride=list(metadata.stride),
             storage_offset=metadata.storage_offset,
             dtype=str(metadata.dtype),
+            storage_nbytes=remote_tensor.untyped_storage().nbytes(),
         )
 
     def remove_tensor_from_remote(
         self, storage_id: int, machine: "RemoteMachine"
     ) -> bool:
         """Remove a tensor from remote storage."""
+        clear_storage_wire_dtype(storage_id)
         try:
             # Use internal client resolution for consistent error handling
             client = self._get_validated_client(machine)
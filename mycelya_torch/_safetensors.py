@@ -0,0 +1,225 @@
+# Copyright (C) 2025 alyxya
+# SPDX-License-Identifier: AGPL-3.0-or-later
+
+"""
+Streaming safetensors loader for remote devices.
+
+The checkpoint is memory-mapped and each tensor's byte range is uploaded
+from the mapping into its remote storage in pipelined chunks, without first
+materializing whole CPU tensors. Chunks are only copied when compressed, and
+small tensors are copied into the shared pack buffer. Pages are released once
+their chunk has been applied, keeping host memory close to the in-flight
+chunk budget and allowing checkpoints larger than client RAM.
+"""
+
+import hashlib
+import json
+import mmap
+import struct
+from collections import deque
+from typing import Dict, List, Optional, Tuple, Union
+
+import torch
+
+from ._logging import get_logger
+from .device import RemoteMachine
+
+log = get_logger(__name__)
+
+# safetensors dtype codes -> torch dtypes available in this build
+_DTYPES: Dict[str, torch.dtype] = {
+    code: getattr(torch, name)
+    for code, name in (
+        ("F64", "float64"),
+        ("F32", "float32"),
+        ("F16", "float16"),
+        ("BF16", "bfloat16"),
+        ("F8_E4M3", "float8_e4m3fn"),
+        ("F8_E5M2", "float8_e5m2"),
+        ("I64", "int64"),
+        ("I32", "int32"),
+        ("I16", "int16"),
+        ("I8", "int8"),
+        ("U64", "uint64"),
+        ("U32", "uint32"),
+        ("U16", "uint16"),
+        ("U8", "uint8"),
+        ("BOOL", "bool"),
+    )
+    if hasattr(torch, name)
+}
+
+
+def _read_header(path: str) -> Tuple[Dict[str, dict], int]:
+    """Read the JSON header of a safetensors file and where its data starts."""
+    with open(path, "rb") as f:
+        (header_len,) = struct.unpack("<Q", f.read(8))
+        header = json.loads(f.read(header_len))
+    header.pop("__metadata__", None)
+    return header, 8 + header_len
+
+
+def _release_pages(mapping: mmap.mmap, offset: int, nbytes: int) -> None:
+    """
+    Drop mapped pages of a byte range that has already been uploaded.
+
+    Only pages lying wholly inside the range are released. Pages shared with
+    a neighbouring tensor may still back one of its chunks in flight.
+    """
+    if not hasattr(mapping, "madvise") or not hasattr(mmap, "MADV_DONTNEED"):
+        return
+    start = -(-offset // mmap.PAGESIZE) * mmap.PAGESIZE
+    end = (offset + nbytes) // mmap.PAGESIZE * mmap.PAGESIZE
+    if end > start:
+        mapping.madvise(mmap.MADV_DONTNEED, start, end - start)
+
+
+def load_safetensors(
+    path: str,
+    device: Union[RemoteMachine, torch.device, str],
+    dedup: bool = False,
+) -> Dict[str, torch.Tensor]:
+    """
+    Load a safetensors checkpoint directly into remote storages.
+
+    All remote tensors are allocated up front, then their bytes are streamed
+    from a memory mapping of the file in file order. Tensors smaller than
+    DELTA_CHUNK_BYTES are packed into shared payloads; larger ones are sent
+    as TRANSFER_CHUNK_BYTES chunks with at most MAX_INFLIGHT_CHUNKS chunks'
+    worth of bytes outstanding.
+
+    With dedup, streamed tensors of at least DEDUP_MIN_BYTES are hashed and
+    looked up in the server's blob store in one round trip first. Hits are
+    copied on the server and not sent; misses are sent and then saved to the
+    store for the next load.
+
+    Args:
+        path: Path to a .safetensors file
+        device: RemoteMachine or remote torch.device to load onto
+        dedup: Whether to deduplicate large tensors against the blob store
+
+    Returns:
+        Dict mapping tensor names to remote tensors
+
+    Raises:
+        ValueError: If device is not remote or the file uses an unknown dtype
+    """
+    from ._remote_orchestrator import remote_orchestrator
+    from ._tensor_utils import (
+        DEDUP_MIN_BYTES,
+        DELTA_CHUNK_BYTES,
+        MAX_INFLIGHT_CHUNKS,
+        TRANSFER_CHUNK_BYTES,
+        HostBuffer,
+    )
+
+    if isinstance(device, RemoteMachine):
+        device = device.device()
+    device = torch.device(device)
+    if device.type != "mycelya":
+        raise ValueError(f"load_safetensors requires a remote device, got {device}")
+
+    header, data_start = _read_header(path)
+
+    # Allocate every remote tensor first so storage creation is batched
+    tensors: Dict[str, torch.Tensor] = {}
+    uploads: List[Tuple[torch.Tensor, int, int]] = []
+    for name, info in header.items():
+        if info["dtype"] not in _DTYPES:
+            raise ValueError(f"Unsupported safetensors dtype {info['dtype']!r}")
+        dtype = _DTYPES[info["dtype"]]
+        tensor = torch.empty(info["shape"], dtype=dtype, device=device)
+        begin, end = info["data_offsets"]
+        if end - begin != tensor.numel() * tensor.element_size():
+            raise ValueError(f"Tensor {name!r} has inconsistent data offsets")
+        tensors[name] = tensor
+        if end > begin:
+            uploads.append((tensor, data_start + begin, end - begin))
+    uploads.sort(key=lambda upload: upload[1])
+
+    if not uploads:
+        return tensors
+
+    with open(path, "rb") as f:
+        mapping = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_COPY)
+    file_bytes = torch.frombuffer(mapping, dtype=torch.uint8)
+
+    budget = MAX_INFLIGHT_CHUNKS * TRANSFER_CHUNK_BYTES
+    inflight: deque = deque()
+    inflight_bytes = 0
+    clients = set()
+
+    def _retire() -> None:
+        nonlocal inflight_bytes
+        future, offset, nbytes = inflight.popleft()
+        if future is not None:
+            future.result()
+        inflight_bytes -= nbytes
+        _release_pages(mapping, offset, nbytes)
+
+    try:
+        # upload index -> digest of a blob store miss, saved once sent, or
+        # None for a hit that is not sent at all
+        digests: Dict[int, Optional[str]] = {}
+        if dedup:
+            lookups = []
+            for index, (tensor, offset, nbytes) in enumerate(uploads):
+                if nbytes < max(DEDUP_MIN_BYTES, DELTA_CHUNK_BYTES):
+                    continue
+                storage_id = tensor.untyped_storage().data_ptr()
+                client = remote_orchestrator._get_client_for_storage(storage_id)
+                digest = hashlib.blake2b(
+                    file_bytes[offset : offset + nbytes].numpy(), digest_size=32
+                ).hexdigest()
+                _release_pages(mapping, offset, nbytes)
+                future = client._write_storage_from_blob(storage_id, 0, digest, nbytes)
+                lookups.append((index, digest, future, client))
+            for index, digest, future, client in lookups:
+                found = future.result()
+                client._record_dedup(found, uploads[index][2])
+                digests[index] = None if found else digest
+
+        for index, (tensor, offset, nbytes) in enumerate(uploads):
+            if index in digests and digests[index] is None:
+                continue
+            storage_id = tensor.untyped_storage().data_ptr()
+            client = remote_orchestrator._get_client_for_storage(storage_id)
+            clients.add(client)
+
+            if nbytes < DELTA_CHUNK_BYTES:
+                # Copied into the pack buffer right away
+                client._pack_upload(
+                    storage_id, file_bytes[offset : offset + nbytes], 0
+                )
+                _release_pages(mapping, offset, nbytes)
+                continue
+
+            for chunk_offset in range(0, nbytes, TRANSFER_CHUNK_BYTES):
+                length = min(TRANSFER_CHUNK_BYTES, nbytes - chunk_offset)
+                start = offset + chunk_offset
+                payload = client._encode_upload_payload(
+                    HostBuffer(file_bytes[start : start + length])
+                )
+                future = client._write_storage_bytes(storage_id, chunk_offset, payload)
+                inflight.append((future, start, length))
+                inflight_bytes += length
+                while inflight_bytes > budget:
+                    _retire()
+            if digests.get(index) is not None:
+                client._save_storage_blob(storage_id, 0, nbytes, digests[index])
+
+        for client in clients:
+            client._flush_packed_uploads()
+        while inflight:
+            _retire()
+    finally:
+        del file_bytes
+        try:
+            mapping.close()
+        except BufferError:
+            # Queued payloads still reference the mapping; it is unmapped
+            # once they are released
+            pass
+
+    log.info(f"📦 Loaded {len(tensors)} tensors from {path} onto {device}")
+    return tensors
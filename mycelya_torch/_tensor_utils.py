@@ -11,16 +11,37 @@ This module provides a clean, type-safe API for tensor conversions:
 - Serialization utilities for data transfer
 """
 
+import pickle
 from abc import ABC, abstractmethod
 from dataclasses import dataclass
-from typing import Any, Dict, Tuple, Union
+from typing import Any, Callable, Dict, Iterator, List, Optional, Tuple, Union
 
 import torch
 
+from ._batching import DeferredArg
 from ._logging import get_logger
 
 log = get_logger(__name__)
 
+# Transfers at least this large are streamed in chunks of this size
+TRANSFER_CHUNK_BYTES = 64 * 1024 * 1024
+
+# Chunks in flight at once for a streamed transfer, bounding host memory
+MAX_INFLIGHT_CHUNKS = 4
+
+# Granularity of change detection for delta uploads; uploads at least this
+# large into a contiguous target are hashed and only changed chunks are sent
+DELTA_CHUNK_BYTES = 1024 * 1024
+
+# Checkpoint tensors at least this large are looked up by content hash in the
+# server's blob store when loaded with dedup, turning repeated loads into
+# server-side copies
+DEDUP_MIN_BYTES = 16 * 1024 * 1024
+
+# Size of the buffer that packs small blocking uploads (e.g. the parameters of
+# Module.to or load_state_dict) into a single payload with an offset table
+PACK_BUFFER_BYTES = 8 * 1024 * 1024
+
 
 @dataclass
 class BaseTensorMetadata(ABC):
@@ -249,6 +270,183 @@ def cpu_tensor_to_numpy_bytes(tensor: torch.Tensor) -> bytes:
     return tensor.numpy().tobytes()
 
 
+class HostBuffer:
+    """
+    Zero-copy view over the bytes of a contiguous CPU tensor.
+
+    Transports that understand the buffer protocol read the tensor memory
+    through ``view`` directly. When pickled (e.g. for Modal RPCs) the bytes are
+    written straight from tensor memory into the pickle stream and arrive on
+    the other side as a writable ``memoryview``, so no intermediate ``bytes``
+    copy is made on either end.
+    """
+
+    __slots__ = ("_tensor", "view")
+
+    def __init__(self, tensor: torch.Tensor):
+        if not tensor.is_contiguous():
+            raise ValueError("HostBuffer requires a contiguous tensor")
+        # Keep the tensor alive for as long as the view is referenced
+        self._tensor = tensor
+        self.view = memoryview(tensor.reshape(-1).view(torch.uint8).numpy())
+
+    @property
+    def nbytes(self) -> int:
+        return self.view.nbytes
+
+    def __len__(self) -> int:
+        return self.view.nbytes
+
+    def __reduce_ex__(self, protocol: int):
+        # Only builtins may appear here: the server does not import mycelya_torch
+        if protocol >= 5:
+            return (memoryview, (pickle.PickleBuffer(self.view),))
+        return (memoryview, (bytearray(self.view),))
+
+
+def is_pinned_host_tensor(tensor: torch.Tensor) -> bool:
+    """
+    Check whether a CPU tensor lives in the mycelya pinned staging pool.
+
+    Args:
+        tensor: CPU tensor to check
+
+    Returns:
+        True if the tensor storage was allocated by pin_memory("mycelya")
+    """
+    from ._C import _is_pinned_ptr
+
+    if tensor.device.type != "cpu":
+        return False
+    return _is_pinned_ptr(tensor.untyped_storage().data_ptr())
+
+
+def cpu_tensor_to_host_buffer(
+    tensor: torch.Tensor, snapshot: bool = False
+) -> HostBuffer:
+    """
+    Convert a CPU tensor to a zero-copy transfer payload.
+
+    Contiguous tensors are exposed directly through the buffer protocol.
+    Non-contiguous tensors are packed into row-major order exactly once, so the
+    payload always holds the source view's elements in source_shape order.
+
+    Args:
+        tensor: CPU tensor to serialize
+        snapshot: If True, never alias the caller's memory, for payloads that
+            are serialized after the caller may have modified the tensor
+
+    Returns:
+        HostBuffer over the packed tensor bytes
+
+    Raises:
+        ValueError: If tensor is not on CPU device
+    """
+    if tensor.device.type != "cpu":
+        raise ValueError(f"Expected CPU tensor, got device: {tensor.device}")
+
+    tensor = tensor.detach()
+    if tensor.is_contiguous():
+        return HostBuffer(tensor.clone() if snapshot else tensor)
+    # contiguous() packs non-contiguous tensors into fresh memory exactly once
+    return HostBuffer(tensor.contiguous())
+
+
+def contiguous_strides(shape: List[int]) -> List[int]:
+    """Get the row-major strides for a shape."""
+    strides = []
+    stride = 1
+    for size in reversed(shape):
+        strides.append(stride)
+        stride *= max(size, 1)
+    return list(reversed(strides))
+
+
+def iter_tensor_chunks(
+    tensor: torch.Tensor, chunk_bytes: int
+) -> Iterator[Tuple[int, torch.Tensor]]:
+    """
+    Split a CPU tensor into packed row-major byte chunks.
+
+    Contiguous tensors are sliced without copying. Non-contiguous tensors are
+    packed one group of leading-dimension rows at a time, so at most one chunk
+    is materialized per step.
+
+    Args:
+        tensor: CPU tensor to split
+        chunk_bytes: Target chunk size in bytes
+
+    Yields:
+        Tuples of (byte offset in the packed tensor, 1D uint8 chunk tensor)
+    """
+    tensor = tensor.detach()
+    if tensor.is_contiguous():
+        flat = tensor.reshape(-1).view(torch.uint8)
+        for offset in range(0, flat.numel(), chunk_bytes):
+            yield offset, flat[offset : offset + chunk_bytes]
+        return
+
+    row_bytes = (tensor.numel() // tensor.shape[0]) * tensor.element_size()
+    rows_per_chunk = max(1, chunk_bytes // row_bytes)
+    for row in range(0, tensor.shape[0], rows_per_chunk):
+        chunk = tensor[row : row + rows_per_chunk].contiguous()
+        yield row * row_bytes, chunk.reshape(-1).view(torch.uint8)
+
+
+class AsyncHostCopy(DeferredArg):
+    """
+    Upload payload staged on the extension's copy worker pool.
+
+    Non-pinned sources are packed into a pinned staging buffer off the calling
+    thread, which frees the caller to reuse its tensor once the copy finishes.
+    Pinned contiguous sources are sent straight from their own buffer, as with
+    CUDA non_blocking copies the caller must not modify them until synchronized.
+
+    An optional encode callable (e.g. compression) is applied to the staged
+    buffer when the payload is resolved on the sender thread.
+    """
+
+    def __init__(
+        self,
+        tensor: torch.Tensor,
+        encode: Optional[Callable[[HostBuffer], Any]] = None,
+    ):
+        from ._C import _host_copy_async
+
+        self._encode = encode
+        if tensor.is_contiguous() and is_pinned_host_tensor(tensor):
+            self._staging, self._ticket = tensor.detach(), None
+        else:
+            self._staging, self._ticket = _host_copy_async(tensor.detach())
+
+    @property
+    def nbytes(self) -> int:
+        return self._staging.nbytes
+
+    def discard(self) -> None:
+        # Let the staging copy finish so its ticket is released
+        from ._C import _host_copy_wait
+
+        if self._ticket is not None:
+            _host_copy_wait(self._ticket)
+            self._ticket = None
+
+    def done(self) -> bool:
+        """Check whether the staging copy has finished."""
+        from ._C import _host_copy_query
+
+        return self._ticket is None or _host_copy_query(self._ticket)
+
+    def resolve(self) -> Any:
+        from ._C import _host_copy_wait
+
+        if self._ticket is not None:
+            _host_copy_wait(self._ticket)
+            self._ticket = None
+        buffer = HostBuffer(self._staging)
+        return buffer if self._encode is None else self._encode(buffer)
+
+
 def numpy_bytes_to_cpu_tensor(
     data: bytes, shape: Tuple[int, ...], dtype: torch.dtype
 ) -> torch.Tensor:
@@ -266,8 +464,12 @@ def numpy_bytes_to_cpu_tensor(
     Returns:
         CPU tensor reconstructed from serialized bytes
     """
-    # Create a writable bytearray to avoid PyTorch warnings about non-writable buffers
-    writable_data = bytearray(data)
+    # Writable views (e.g. from an in-process transport) are wrapped as is;
+    # otherwise copy into a bytearray to avoid warnings about non-writable buffers
+    if isinstance(data, memoryview) and not data.readonly:
+        writable_data = data
+    else:
+        writable_data = bytearray(data)
 
     # Use torch.frombuffer with the writable buffer - no clone needed since temp tensor
     return torch.frombuffer(writable_data, dtype=dtype).reshape(shape)
@@ -0,0 +1,124 @@
+# Copyright (C) 2025 alyxya
+# SPDX-License-Identifier: AGPL-3.0-or-later
+
+"""
+Transports for storage bytes moving between a client and its server.
+
+A transport decides how upload payloads are wrapped before they are handed to
+the server and how download payloads are unwrapped afterwards. Clients own one
+transport and route every storage transfer through it:
+
+- NetworkTransport pickles tensor memory from buffer views and compresses it
+  when that pays off. Used for servers reached over the network.
+- InProcessTransport passes buffers by reference to a server running in the
+  same process (mock execution), so neither side makes a serialization copy
+  and benchmarks only pay for the copies the real system also makes. It can
+  be told to compress like NetworkTransport so codecs are exercised in tests.
+"""
+
+from abc import ABC, abstractmethod
+from typing import Any, Dict, Optional, Tuple
+
+from ._tensor_utils import HostBuffer
+
+
+class Transport(ABC):
+    """Encoding of storage payloads exchanged with a server."""
+
+    @abstractmethod
+    def encode_upload(self, buffer: HostBuffer) -> Tuple[Any, int, Optional[str]]:
+        """
+        Wrap an upload for the server.
+
+        Args:
+            buffer: HostBuffer over the packed source bytes
+
+        Returns:
+            Tuple of (payload, bytes on the wire, codec used or None)
+        """
+        pass
+
+    @abstractmethod
+    def download_kwargs(self) -> Dict[str, Any]:
+        """Get the kwargs telling the server how to return downloaded bytes."""
+        pass
+
+    @abstractmethod
+    def decode_download(self, payload: Any) -> Tuple[Any, int, Optional[str]]:
+        """
+        Unwrap a download returned by the server.
+
+        Args:
+            payload: Value returned by get_storage_data or read_storage_bytes
+
+        Returns:
+            Tuple of (bytes-like object, bytes on the wire, codec used or None)
+        """
+        pass
+
+
+class NetworkTransport(Transport):
+    """Pickled buffer views with adaptive compression, for remote servers."""
+
+    def encode_upload(self, buffer: HostBuffer) -> Tuple[Any, int, Optional[str]]:
+        from ._compression import accepted_codecs, choose_codec, compress
+
+        codec = choose_codec(buffer.view, accepted_codecs())
+        if codec is None:
+            return buffer, buffer.nbytes, None
+        data = compress(codec, buffer.view)
+        return (codec, data), len(data), codec
+
+    def download_kwargs(self) -> Dict[str, Any]:
+        from ._compression import accepted_codecs
+
+        codecs = accepted_codecs()
+        return {"accept_codecs": codecs} if codecs else {}
+
+    def decode_download(self, payload: Any) -> Tuple[Any, int, Optional[str]]:
+        from ._compression import decode_payload
+
+        raw_bytes, codec, wire_bytes = decode_payload(payload)
+        return raw_bytes, wire_bytes, codec
+
+
+class InProcessTransport(Transport):
+    """Buffers passed by reference, for a server running in this process."""
+
+    def __init__(self, compression: bool = False):
+        # Compress payloads the way NetworkTransport does, still passing
+        # uncompressed buffers by reference
+        self.compression = compression
+
+    def encode_upload(self, buffer: HostBuffer) -> Tuple[Any, int, Optional[str]]:
+        if self.compression:
+            from ._compression import accepted_codecs, choose_codec, compress
+
+            codec = choose_codec(buffer.view, accepted_codecs())
+            if codec is not None:
+                data = compress(codec, buffer.view)
+                return (codec, data), len(data), codec
+            return buffer.view, buffer.nbytes, None
+
+        # The server reads tensor memory through the view; nothing is copied
+        # until it lands in the destination storage
+        return buffer.view, 0, None
+
+    def download_kwargs(self) -> Dict[str, Any]:
+        if self.compression:
+            from ._compression import accepted_codecs
+
+            codecs = accepted_codecs()
+            return {"accept_codecs": codecs} if codecs else {}
+        return {"as_tensor": True}
+
+    def decode_download(self, payload: Any) -> Tuple[Any, int, Optional[str]]:
+        if self.compression:
+            from ._compression import decode_payload
+
+            raw_bytes, codec, wire_bytes = decode_payload(payload)
+            return raw_bytes, wire_bytes, codec
+
+        # The server hands back a private uint8 CPU tensor; expose its memory
+        # as a writable view so callers can wrap it without copying
+        return memoryview(payload.numpy()), 0, None
@@ -0,0 +1,118 @@
+# Copyright (C) 2025 alyxya
+# SPDX-License-Identifier: AGPL-3.0-or-later
+
+"""
+Reduced-precision wire formats for storage transfers.
+
+An opt-in policy sends floating point data as float16, bfloat16 or fp8 and
+restores the destination dtype on arrival. Uploads are narrowed on the CPU
+and widened on the remote device; downloads are narrowed on the remote device
+and widened on the CPU. The conversion is lossy, so it is only applied when
+requested, either per call with the wire_dtype() context manager or per
+remote tensor with set_wire_dtype().
+"""
+
+import contextlib
+import threading
+from typing import Dict, Iterator, Optional
+
+import torch
+
+# Dtypes accepted as wire formats (fp8 only where this torch build has it)
+WIRE_DTYPES = tuple(
+    getattr(torch, name)
+    for name in ("float16", "bfloat16", "float8_e4m3fn", "float8_e5m2")
+    if hasattr(torch, name)
+)
+
+# storage_id -> wire dtype for transfers into or out of that remote storage
+_storage_wire_dtypes: Dict[int, torch.dtype] = {}
+
+_local = threading.local()
+
+
+def _check_wire_dtype(dtype: Optional[torch.dtype]) -> None:
+    if dtype is not None and dtype not in WIRE_DTYPES:
+        raise ValueError(
+            f"Unsupported wire dtype {dtype}, expected one of {WIRE_DTYPES}"
+        )
+
+
+@contextlib.contextmanager
+def wire_dtype(dtype: Optional[torch.dtype]) -> Iterator[None]:
+    """
+    Transfer floating point data as dtype for copies made in this block.
+
+    Takes precedence over per-tensor policies; pass None to force full
+    precision inside the block.
+
+    Args:
+        dtype: Wire dtype, or None for full precision
+
+    Raises:
+        ValueError: If dtype is not a supported wire dtype
+    """
+    _check_wire_dtype(dtype)
+    stack = getattr(_local, "stack", None)
+    if stack is None:
+        stack = _local.stack = []
+    stack.append(dtype)
+    try:
+        yield
+    finally:
+        stack.pop()
+
+
+def set_wire_dtype(tensor: torch.Tensor, dtype: Optional[torch.dtype]) -> None:
+    """
+    Transfer a remote tensor's storage as dtype for uploads and downloads.
+
+    Args:
+        tensor: Remote tensor whose storage the policy applies to
+        dtype: Wire dtype, or None to clear the policy
+
+    Raises:
+        ValueError: If tensor is not remote or dtype is unsupported
+    """
+    if tensor.device.type != "mycelya":
+        raise ValueError("set_wire_dtype requires a remote tensor")
+    _check_wire_dtype(dtype)
+
+    storage_id = tensor.untyped_storage().data_ptr()
+    if dtype is None:
+        _storage_wire_dtypes.pop(storage_id, None)
+    else:
+        _storage_wire_dtypes[storage_id] = dtype
+
+
+def clear_storage_wire_dtype(storage_id: int) -> None:
+    """Drop the policy of a freed storage so a reused ID starts clean."""
+    _storage_wire_dtypes.pop(storage_id, None)
+
+
+def resolve_wire_dtype(
+    remote: torch.Tensor, local_dtype: torch.dtype
+) -> Optional[torch.dtype]:
+    """
+    Get the narrower dtype to transfer a remote tensor's data as, if any.
+
+    Args:
+        remote: Remote side of the copy
+        local_dtype: Dtype of the CPU side of the copy
+
+    Returns:
+        Wire dtype if a policy applies and actually narrows both sides,
+        None to transfer at full precision
+    """
+    stack = getattr(_local, "stack", None)
+    if stack:
+        dtype = stack[-1]
+    else:
+        dtype = _storage_wire_dtypes.get(remote.untyped_storage().data_ptr())
+    if dtype is None:
+        return None
+
+    for side in (remote.dtype, local_dtype):
+        if not side.is_floating_point or side.itemsize <= dtype.itemsize:
+            return None
+    return dtype
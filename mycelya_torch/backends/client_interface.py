@@ -8,12 +8,24 @@ This module defines the base interface that all cloud provider clients must impl
 ensuring consistent API across different backends (Modal, AWS, GCP, Azure, etc.).
 """
 
+import itertools
+import threading
+import time
 from abc import ABC, abstractmethod
-from typing import Any, Dict, List, Optional, Union
+from collections import OrderedDict, deque
+from concurrent.futures import Future
+from typing import Any, Dict, List, Optional, Tuple, Union
 
 import torch
 
-from .._batching import RPCBatchQueue
+from .._batching import (
+    BatchPipeline,
+    RPCBatchQueue,
+    _payload_nbytes,
+    no_backpressure,
+)
+from .._flush_policy import FlushPolicy
+from .._transport import NetworkTransport, Transport
 
 
 class ClientInterface(ABC):
@@ -35,15 +47,76 @@ class ClientInterface(ABC):
         self.gpu_type = gpu_type
         self.machine_id = machine_id
 
-        # Storage cache: storage_id -> underlying 1D uint8 CPU tensor
-        self._storage_cache: Dict[int, torch.Tensor] = {}
+        # Storage versions: storage_id -> version of its latest queued write.
+        # Versions come from one monotonic clock and are bumped at queue time,
+        # so a cached copy is current iff it was tagged with the same version
+        self._storage_versions: Dict[int, int] = {}
+        self._version_clock = itertools.count(1)
+
+        # Storage cache: storage_id -> (version, underlying 1D uint8 CPU
+        # tensor), in LRU order (least recently used first) and bounded by a
+        # byte budget. Stale entries are dropped lazily on lookup or eviction
+        self._storage_cache: "OrderedDict[int, Tuple[int, torch.Tensor]]" = (
+            OrderedDict()
+        )
+        self._cache_entry_hits: Dict[int, int] = {}
+        self._cache_bytes = 0
+        self._cache_lock = threading.Lock()
+
+        # Cache limits: total bytes of cached storages, and the size above
+        # which a storage is never cached (None for no per-storage limit)
+        self._cache_max_bytes = 2 * 1024 * 1024 * 1024
+        self._cache_max_entry_bytes: Optional[int] = None
 
         # Track cache statistics for debugging
         self._cache_hits = 0
         self._cache_misses = 0
+        self._cache_evictions = 0
+        self._cache_stale = 0
+
+        # Views spanning at least this fraction of their storage fetch and
+        # cache the whole storage; smaller views fetch only their own bytes
+        self._full_fetch_ratio = 0.5
+
+        # Delta uploads: storage_id -> (version, byte offset, nbytes,
+        # per-chunk hashes, write futures) of the last upload, valid while the
+        # storage is still at that version and once all its writes succeeded
+        self._chunk_hashes: Dict[
+            int, Tuple[int, int, int, torch.Tensor, List[Future]]
+        ] = {}
+
+        # Upload deduplication against the server's content-addressed blob store
+        self._dedup_stats = {"hits": 0, "misses": 0, "bytes_saved": 0}
+
+        # Packed uploads: small uploads copied into one buffer, sent together
+        # as (storage_id, byte_offset, payload_offset, nbytes) entries before
+        # any other RPC so they keep their place in the op stream
+        self._pack_buffer: Optional[torch.Tensor] = None
+        self._pack_entries: List[Tuple[int, int, int, int]] = []
+        self._pack_used = 0
+        self._pack_started_at: Optional[float] = None
+        self._pack_lock = threading.RLock()
+
+        # How storage payloads travel to and from the server
+        self._transport = self._create_transport()
+
+        # Transfer statistics: raw vs on-the-wire bytes and codec usage
+        self._transfer_stats: Dict[str, Dict[str, int]] = {
+            direction: {"raw_bytes": 0, "wire_bytes": 0, "transfers": 0}
+            for direction in ("upload", "download")
+        }
+        self._codec_counts: Dict[str, int] = {}
+        self._transfer_stats_lock = threading.Lock()
 
-        # RPC batching queue
+        # RPC batching queue, the policy deciding when it is sent, and the
+        # pipeline keeping several sent batches in flight
         self._batch_queue = RPCBatchQueue(client_id=machine_id)
+        self._flush_policy = FlushPolicy()
+        self._batch_pipeline = BatchPipeline(client_id=machine_id)
+
+        # Index of this client's device, resolved when first needed to look up
+        # the calling thread's current stream
+        self._device_index: Optional[int] = None
 
         # Register with orchestrator for batching (will be done in subclass start())
         self._registered_for_batching = False
@@ -135,7 +208,8 @@ class ClientInterface(ABC):
         target_stride: List[int],
         target_storage_offset: int,
         target_dtype: str,
-    ) -> None:
+        non_blocking: bool = False,
+    ) -> Optional[Future]:
         """
         Update an existing storage with raw tensor data.
 
@@ -153,9 +227,10 @@ class ClientInterface(ABC):
             target_stride: Stride of the target view in storage
             target_storage_offset: Storage offset of the target view in storage
             target_dtype: Data type of the target view in storage
+            non_blocking: If True, stage the source off-thread and return immediately
 
         Returns:
-            None
+            Future resolved once the write is applied if non_blocking, None otherwise
         """
         pass
 
@@ -163,20 +238,145 @@ class ClientInterface(ABC):
     def _get_storage_data(
         self,
         storage_id: int,
+        shape: Optional[List[int]] = None,
+        stride: Optional[List[int]] = None,
+        storage_offset: int = 0,
+        dtype: Optional[str] = None,
     ) -> bytes:
         """
         Retrieve raw storage data by ID.
 
-        Returns the complete raw untyped storage bytes. The client interface layer
-        will handle tensor reconstruction from metadata and these raw bytes.
+        Returns the complete raw untyped storage bytes, or when shape is given
+        only the elements of that view gathered row-major on the remote side.
+        The client interface layer will handle tensor reconstruction from
+        metadata and these raw bytes.
 
         This is a private method used internally by get_storage_tensor().
 
         Args:
             storage_id: The storage ID to retrieve
+            shape: Shape of the view to gather, or None for the whole storage
+            stride: Stride of the view to gather
+            storage_offset: Storage offset of the view to gather
+            dtype: Data type of the view to gather
+
+        Returns:
+            Raw bytes of the storage or of the gathered view
+        """
+        pass
+
+    def _get_storage_data_async(
+        self,
+        storage_id: int,
+        shape: Optional[List[int]] = None,
+        stride: Optional[List[int]] = None,
+        storage_offset: int = 0,
+        dtype: Optional[str] = None,
+    ) -> Future:
+        """
+        Retrieve raw storage data by ID without blocking the caller.
+
+        Default implementation fetches synchronously and returns a completed
+        Future. Providers with a queued transport should override this.
+
+        Args:
+            storage_id: The storage ID to retrieve
+            shape: Shape of the view to gather, or None for the whole storage
+            stride: Stride of the view to gather
+            storage_offset: Storage offset of the view to gather
+            dtype: Data type of the view to gather
 
         Returns:
-            Raw untyped storage bytes
+            Future resolving to the raw bytes of the storage or view
+        """
+        future = Future()
+        try:
+            future.set_result(
+                self._get_storage_data(
+                    storage_id, shape, stride, storage_offset, dtype
+                )
+            )
+        except Exception as e:
+            future.set_exception(e)
+        return future
+
+    @abstractmethod
+    def _write_storage_bytes(
+        self, storage_id: int, byte_offset: int, payload: Any
+    ) -> Optional[Future]:
+        """
+        Write one chunk of a streamed upload into a storage byte range.
+
+        Args:
+            storage_id: The storage ID to write into
+            byte_offset: Byte offset of the chunk within the storage
+            payload: HostBuffer over the chunk, or a (codec, data) tuple
+
+        Returns:
+            Future resolved once the chunk is applied, or None if already applied
+        """
+        pass
+
+    @abstractmethod
+    def _write_storages_packed(
+        self, entries: List[Tuple[int, int, int, int]], payload: Any
+    ) -> None:
+        """
+        Scatter a packed multi-tensor payload into storage byte ranges.
+
+        Args:
+            entries: (storage_id, byte_offset, payload_offset, nbytes) per tensor
+            payload: HostBuffer over the packed bytes, or a (codec, data) tuple
+        """
+        pass
+
+    @abstractmethod
+    def _write_storage_from_blob(
+        self, storage_id: int, byte_offset: int, digest: str, nbytes: int
+    ) -> Future:
+        """
+        Fill a storage byte range from the server's content-addressed blob store.
+
+        Args:
+            storage_id: The storage ID to write into
+            byte_offset: Byte offset of the range within the storage
+            digest: Content hash of the bytes
+            nbytes: Number of bytes in the range
+
+        Returns:
+            Future resolving to True if the blob was found, False otherwise
+        """
+        pass
+
+    @abstractmethod
+    def _save_storage_blob(
+        self, storage_id: int, byte_offset: int, nbytes: int, digest: str
+    ) -> None:
+        """
+        Save a storage byte range to the server's blob store under its digest.
+
+        Args:
+            storage_id: The storage ID to read from
+            byte_offset: Byte offset of the range within the storage
+            nbytes: Number of bytes in the range
+            digest: Content hash of the bytes
+        """
+        pass
+
+    @abstractmethod
+    def _read_storage_bytes_async(
+        self, storage_id: int, byte_offset: int, nbytes: int
+    ) -> Future:
+        """
+        Read one chunk of a streamed download from a storage byte range.
+
+        Args:
+            storage_id: The storage ID to read from
+            byte_offset: Byte offset of the chunk within the storage
+            nbytes: Number of bytes to read
+
+        Returns:
+            Future resolving to the decompressed chunk bytes
         """
         pass
 
@@ -207,6 +407,7 @@ class ClientInterface(ABC):
         stride: List[int],
         storage_offset: int,
         dtype: str,
+        storage_nbytes: Optional[int] = None,
     ) -> torch.Tensor:
         """
         Retrieve storage data as a tensor with specified view parameters.
@@ -214,7 +415,9 @@ class ClientInterface(ABC):
         This method implements caching by:
         1. Checking if storage_id is in cache
         2. If cached, creating view from cached tensor
-        3. If not cached, making RPC and caching result
+        3. If the view is small relative to its storage, fetching only the
+           view's bytes without caching
+        4. Otherwise, fetching the whole storage and caching it
 
         Args:
             storage_id: The storage ID to retrieve
@@ -222,36 +425,112 @@ class ClientInterface(ABC):
             stride: Tensor stride for view
             storage_offset: Storage offset for view
             dtype: Tensor data type
+            storage_nbytes: Size of the whole storage, if known. When omitted
+                the whole storage is always fetched.
 
         Returns:
             CPU tensor reconstructed from storage with specified view
         """
         # Check cache first
-        if storage_id in self._storage_cache:
-            self._cache_hits += 1
-
-            # Get cached underlying tensor
-            cached_tensor = self._storage_cache[storage_id]
-
+        cached_tensor = self._cache_lookup(storage_id)
+        if cached_tensor is not None:
             # Create view from cached tensor
             return self._create_view_from_cached_tensor(
                 cached_tensor, shape, stride, storage_offset, dtype
             )
 
         # Cache miss - make RPC
-        self._cache_misses += 1
+        from .._tensor_utils import TRANSFER_CHUNK_BYTES
+
+        torch_dtype = getattr(torch, dtype.replace("torch.", ""))
+
+        if not self._should_fetch_full_storage(shape, dtype, storage_nbytes):
+            view_nbytes = torch.Size(shape).numel() * torch_dtype.itemsize
+            if view_nbytes >= TRANSFER_CHUNK_BYTES and self._is_contiguous_view(
+                shape, stride
+            ):
+                # Large contiguous views are a single byte range of the storage
+                data = self._stream_download(
+                    storage_id, storage_offset * torch_dtype.itemsize, view_nbytes
+                )
+                return data.view(torch_dtype).reshape(shape)
+
+            raw_bytes = self._get_storage_data(
+                storage_id, shape, stride, storage_offset, dtype
+            )
+            return self._create_tensor_from_view_bytes(raw_bytes, shape, dtype)
 
-        # Get the actual tensor from the subclass implementation
-        underlying_tensor = self._get_storage_tensor_for_cache(storage_id)
+        # Get the actual tensor, streaming it in chunks if large. The version
+        # is read first so a write queued meanwhile keeps it out of the cache
+        version = self.storage_version(storage_id)
+        if storage_nbytes is not None and storage_nbytes >= TRANSFER_CHUNK_BYTES:
+            underlying_tensor = self._stream_download(storage_id, 0, storage_nbytes)
+        else:
+            underlying_tensor = self._get_storage_tensor_for_cache(storage_id)
 
         # Cache the underlying tensor
-        self._storage_cache[storage_id] = underlying_tensor
+        self._cache_store(storage_id, underlying_tensor, version)
 
         # Create view from cached tensor
         return self._create_view_from_cached_tensor(
             underlying_tensor, shape, stride, storage_offset, dtype
         )
 
+    def get_storage_tensor_async(
+        self,
+        storage_id: int,
+        shape: List[int],
+        stride: List[int],
+        storage_offset: int,
+        dtype: str,
+    ) -> Future:
+        """
+        Retrieve storage data as a tensor without blocking the caller.
+
+        The download is queued behind every operation already queued for this
+        client. Results are not cached, since writes queued before the
+        download completes would make the cached copy stale.
+
+        Args:
+            storage_id: The storage ID to retrieve
+            shape: Tensor shape for view
+            stride: Tensor stride for view
+            storage_offset: Storage offset for view
+            dtype: Tensor data type
+
+        Returns:
+            Future resolving to a CPU tensor with the specified view
+        """
+        result = Future()
+
+        cached_tensor = self._cache_lookup(storage_id)
+        if cached_tensor is not None:
+            result.set_result(
+                self._create_view_from_cached_tensor(
+                    cached_tensor, shape, stride, storage_offset, dtype
+                )
+            )
+            return result
+
+        def _on_data(data_future: Future) -> None:
+            try:
+                raw_bytes = data_future.result()
+                if raw_bytes is None:
+                    raise RuntimeError(
+                        f"Failed to retrieve storage data for storage {storage_id}"
+                    )
+                result.set_result(
+                    self._create_tensor_from_view_bytes(raw_bytes, shape, dtype)
+                )
+            except Exception as e:
+                result.set_exception(e)
+
+        # Nothing is cached here, so only the view itself is fetched
+        self._get_storage_data_async(
+            storage_id, shape, stride, storage_offset, dtype
+        ).add_done_callback(_on_data)
+        return result
+
     @abstractmethod
     def resize_storage(self, storage_id: int, nbytes: int) -> None:
         """
@@ -292,6 +571,8 @@ class ClientInterface(ABC):
         args: List[Any],
         kwargs: Dict[str, Any],
         return_metadata: bool = False,
+        rng_state: Optional[Dict[str, int]] = None,
+        mutated_storage_ids: Optional[List[int]] = None,
     ) -> Optional[List[Dict[str, Any]]]:
         """
         Execute an aten operation on the remote machine with separated input/output specification.
@@ -303,6 +584,9 @@ class ClientInterface(ABC):
             args: Operation arguments (may contain tensor placeholders)
             kwargs: Operation keyword arguments (may contain tensor placeholders)
             return_metadata: If True, return output tensor metadata instead of None
+            rng_state: Philox seed/offset for random operations, None otherwise
+            mutated_storage_ids: Storage IDs of inputs the op writes in place
+                without returning them
 
         Returns:
             None for normal operations, or List[Dict] of output tensor metadata if return_metadata=True
@@ -344,6 +628,391 @@ class ClientInterface(ABC):
         # Return a copy to protect the cache from mutations
         return temp_tensor.clone()
 
+    def _record_transfer(
+        self, direction: str, raw_bytes: int, wire_bytes: int, codec: Optional[str]
+    ) -> None:
+        """Record one storage transfer in the transfer statistics."""
+        with self._transfer_stats_lock:
+            stats = self._transfer_stats[direction]
+            stats["raw_bytes"] += raw_bytes
+            stats["wire_bytes"] += wire_bytes
+            stats["transfers"] += 1
+            key = codec or "none"
+            self._codec_counts[key] = self._codec_counts.get(key, 0) + 1
+
+    def _record_dedup(self, found: bool, nbytes: int) -> None:
+        """Record one blob store lookup in the deduplication statistics."""
+        with self._transfer_stats_lock:
+            self._dedup_stats["hits" if found else "misses"] += 1
+            if found:
+                self._dedup_stats["bytes_saved"] += nbytes
+
+    def _create_transport(self) -> Transport:
+        """
+        Create the transport used for storage payloads.
+
+        Returns:
+            NetworkTransport by default; in-process clients override this
+        """
+        return NetworkTransport()
+
+    def _encode_upload_payload(self, buffer: Any) -> Any:
+        """
+        Wrap an upload payload for the server using this client's transport.
+
+        Args:
+            buffer: HostBuffer over the packed source bytes
+
+        Returns:
+            Payload to pass to the server (e.g. the buffer itself, or a
+            (codec, compressed bytes) tuple)
+        """
+        payload, wire_bytes, codec = self._transport.encode_upload(buffer)
+        self._record_transfer("upload", buffer.nbytes, wire_bytes, codec)
+        return payload
+
+    def _decode_download_payload(self, payload: Any) -> Any:
+        """
+        Unwrap a download payload using this client's transport.
+
+        Args:
+            payload: Value returned by the server
+
+        Returns:
+            Raw bytes-like object
+        """
+        if payload is None:
+            return None
+        raw_bytes, wire_bytes, codec = self._transport.decode_download(payload)
+        self._record_transfer("download", len(raw_bytes), wire_bytes, codec)
+        return raw_bytes
+
+    def _download_kwargs(self) -> Dict[str, Any]:
+        """Get the download kwargs telling the server how to return bytes."""
+        return dict(self._transport.download_kwargs())
+
+    def _upload_storage_range(
+        self, storage_id: int, tensor: torch.Tensor, byte_offset: int
+    ) -> None:
+        """
+        Upload a CPU tensor into a storage byte range, sending only changes.
+
+        Contiguous sources are hashed per DELTA_CHUNK_BYTES chunk. If the same
+        range was the last thing written to this storage and those writes are
+        confirmed, only runs of chunks whose hash changed are sent. Runs of at
+        least TRANSFER_CHUNK_BYTES are streamed, smaller runs are snapshotted
+        and queued without waiting.
+
+        Args:
+            storage_id: The storage ID to write into
+            tensor: CPU tensor whose packed bytes are uploaded
+            byte_offset: Byte offset in the storage where the tensor starts
+        """
+        from .._C import _hash_chunks
+        from .._tensor_utils import DELTA_CHUNK_BYTES
+
+        nbytes = tensor.numel() * tensor.element_size()
+        if not tensor.is_contiguous():
+            self._write_storage_range(storage_id, tensor, byte_offset)
+            return
+
+        data = tensor.detach().reshape(-1).view(torch.uint8)
+        hashes = _hash_chunks(data, DELTA_CHUNK_BYTES)
+
+        runs = [(0, nbytes)]
+        previous = self._chunk_hashes.get(storage_id)
+        if (
+            previous is not None
+            and previous[:3] == (self.storage_version(storage_id), byte_offset, nbytes)
+            and all(f.done() and f.exception() is None for f in previous[4])
+        ):
+            changed = (hashes != previous[3]).nonzero().flatten().tolist()
+            runs = []
+            for chunk in changed:
+                start = chunk * DELTA_CHUNK_BYTES
+                end = min(start + DELTA_CHUNK_BYTES, nbytes)
+                if runs and runs[-1][1] == start:
+                    runs[-1] = (runs[-1][0], end)
+                else:
+                    runs.append((start, end))
+
+        futures = []
+        for start, end in runs:
+            future = self._write_storage_range(
+                storage_id, data[start:end], byte_offset + start
+            )
+            if future is not None:
+                futures.append(future)
+
+        # Record after queueing, tagged with the version of our own writes
+        entry = (self.storage_version(storage_id), byte_offset, nbytes, hashes, futures)
+        self._chunk_hashes[storage_id] = entry
+
+        def _on_write_done(future: Future) -> None:
+            # A failed or dropped write leaves the remote range stale, so the
+            # next upload of it must be sent in full
+            if future.exception() is not None:
+                if self._chunk_hashes.get(storage_id) is entry:
+                    self._chunk_hashes.pop(storage_id, None)
+
+        for future in futures:
+            future.add_done_callback(_on_write_done)
+
+    def _write_storage_range(
+        self, storage_id: int, tensor: torch.Tensor, byte_offset: int
+    ) -> Optional[Future]:
+        """
+        Write a CPU tensor's packed bytes into a storage byte range.
+
+        Returns:
+            Future resolved once a queued write is applied, or None if the
+            write was streamed and already applied
+        """
+        from .._tensor_utils import TRANSFER_CHUNK_BYTES, cpu_tensor_to_host_buffer
+
+        if tensor.numel() * tensor.element_size() >= TRANSFER_CHUNK_BYTES:
+            self._stream_upload(storage_id, tensor, byte_offset)
+            return None
+
+        # The write may be serialized after this returns, so snapshot it
+        payload = self._encode_upload_payload(
+            cpu_tensor_to_host_buffer(tensor, snapshot=True)
+        )
+        return self._write_storage_bytes(storage_id, byte_offset, payload)
+
+    def _pack_upload(
+        self, storage_id: int, tensor: torch.Tensor, byte_offset: int
+    ) -> None:
+        """
+        Add a small upload to the packed payload sent before the next RPC.
+
+        The tensor is copied (packed row-major) into the shared buffer, so the
+        caller may reuse it immediately, and the whole buffer goes out as one
+        write_storages_packed call instead of one update_storage per tensor.
+
+        Args:
+            storage_id: The storage ID to write into
+            tensor: CPU tensor whose packed bytes are uploaded
+            byte_offset: Byte offset in the storage where the tensor starts
+        """
+        from .._tensor_utils import PACK_BUFFER_BYTES
+
+        nbytes = tensor.numel() * tensor.element_size()
+        if nbytes == 0:
+            return
+
+        self._batch_queue.wait_for_capacity(nbytes, self._wake_batch_thread)
+        with self._pack_lock:
+            self.invalidate_storage_cache(storage_id)
+
+            # Align each tensor so its slice can be viewed as its dtype
+            align = tensor.element_size()
+            offset = (self._pack_used + align - 1) // align * align
+            if self._pack_buffer is not None and offset + nbytes > PACK_BUFFER_BYTES:
+                self._flush_packed_uploads()
+                offset = 0
+            if self._pack_buffer is None:
+                self._pack_buffer = torch.empty(
+                    max(PACK_BUFFER_BYTES, nbytes), dtype=torch.uint8
+                )
+
+            dst = self._pack_buffer[offset : offset + nbytes]
+            dst.view(tensor.dtype).view(tensor.shape).copy_(tensor.detach())
+            self._pack_entries.append((storage_id, byte_offset, offset, nbytes))
+            self._pack_used = offset + nbytes
+            first_entry = self._pack_started_at is None
+            if first_entry:
+                self._pack_started_at = time.monotonic()
+
+        # Let the batch thread schedule the age deadline of the new pack
+        if first_entry:
+            self._wake_batch_thread()
+
+    def _flush_packed_uploads(self) -> None:
+        """Send the pending packed uploads, if any, as a single RPC."""
+        from .._tensor_utils import HostBuffer
+
+        with self._pack_lock:
+            if not self._pack_entries:
+                return
+            entries = self._pack_entries
+            packed = self._pack_buffer[: self._pack_used]
+            self._pack_buffer = None
+            self._pack_entries = []
+            self._pack_used = 0
+            self._pack_started_at = None
+
+            payload = self._encode_upload_payload(HostBuffer(packed))
+            # Runs with the pack lock held, which the sender needs to drain
+            with no_backpressure():
+                self._write_storages_packed(entries, payload)
+
+    def _stream_upload(
+        self, storage_id: int, tensor: torch.Tensor, byte_offset: int
+    ) -> None:
+        """
+        Upload a CPU tensor into a storage byte range in pipelined chunks.
+
+        Chunks are packed (and compressed) on this thread while earlier chunks
+        are sent and copied to the device, with at most MAX_INFLIGHT_CHUNKS
+        outstanding so host memory stays flat. Contiguous chunks alias the
+        caller's tensor, so this returns only once every chunk is applied.
+
+        Args:
+            storage_id: The storage ID to write into
+            tensor: CPU tensor whose packed bytes are uploaded
+            byte_offset: Byte offset in the storage where the tensor starts
+        """
+        from .._tensor_utils import (
+            MAX_INFLIGHT_CHUNKS,
+            TRANSFER_CHUNK_BYTES,
+            HostBuffer,
+            iter_tensor_chunks,
+        )
+
+        self.invalidate_storage_cache(storage_id)
+
+        inflight: deque = deque()
+        for chunk_offset, chunk in iter_tensor_chunks(tensor, TRANSFER_CHUNK_BYTES):
+            payload = self._encode_upload_payload(HostBuffer(chunk))
+            future = self._write_storage_bytes(
+                storage_id, byte_offset + chunk_offset, payload
+            )
+            if future is not None:
+                inflight.append(future)
+                if len(inflight) >= MAX_INFLIGHT_CHUNKS:
+                    inflight.popleft().result()
+
+        for future in inflight:
+            future.result()
+
+    def _stream_download(
+        self, storage_id: int, byte_offset: int, nbytes: int
+    ) -> torch.Tensor:
+        """
+        Download a storage byte range in pipelined chunks.
+
+        Each chunk is copied into the result as soon as it arrives, with at most
+        MAX_INFLIGHT_CHUNKS outstanding, so peak host memory is the result plus
+        a bounded number of chunks.
+
+        Args:
+            storage_id: The storage ID to read from
+            byte_offset: Byte offset of the range within the storage
+            nbytes: Number of bytes to read
+
+        Returns:
+            1D uint8 CPU tensor holding the byte range
+        """
+        from .._tensor_utils import MAX_INFLIGHT_CHUNKS, TRANSFER_CHUNK_BYTES
+
+        result = torch.empty(nbytes, dtype=torch.uint8)
+        result_view = memoryview(result.numpy())
+
+        def _drain(entry) -> None:
+            offset, future = entry
+            chunk = future.result()
+            result_view[offset : offset + len(chunk)] = chunk
+
+        inflight: deque = deque()
+        for offset in range(0, nbytes, TRANSFER_CHUNK_BYTES):
+            length = min(TRANSFER_CHUNK_BYTES, nbytes - offset)
+            future = self._read_storage_bytes_async(
+                storage_id, byte_offset + offset, length
+            )
+            inflight.append((offset, future))
+            if len(inflight) >= MAX_INFLIGHT_CHUNKS:
+                _drain(inflight.popleft())
+
+        while inflight:
+            _drain(inflight.popleft())
+        return result
+
+    def _streamable_upload_offset(
+        self,
+        source_shape: List[int],
+        source_dtype: str,
+        target_shape: List[int],
+        target_stride: List[int],
+        target_storage_offset: int,
+        target_dtype: str,
+    ) -> Optional[int]:
+        """
+        Get the storage byte offset for a streamed upload, if one is possible.
+
+        Streaming writes packed source bytes directly into storage, which is
+        only valid when the target is a contiguous view of the same shape and
+        dtype as the source.
+
+        Returns:
+            Byte offset of the target view in its storage, or None
+        """
+        if source_dtype != target_dtype or list(source_shape) != list(target_shape):
+            return None
+        if not self._is_contiguous_view(target_shape, target_stride):
+            return None
+        torch_dtype = getattr(torch, target_dtype.replace("torch.", ""))
+        return target_storage_offset * torch_dtype.itemsize
+
+    @staticmethod
+    def _is_contiguous_view(shape: List[int], stride: List[int]) -> bool:
+        """Check whether a view is row-major contiguous (ignoring size-1 dims)."""
+        from .._tensor_utils import contiguous_strides
+
+        return all(
+            size <= 1 or actual == expected
+            for size, actual, expected in zip(
+                shape, stride, contiguous_strides(shape)
+            )
+        )
+
+    def _should_fetch_full_storage(
+        self, shape: List[int], dtype: str, storage_nbytes: Optional[int]
+    ) -> bool:
+        """
+        Decide whether a download should fetch and cache the whole storage.
+
+        Args:
+            shape: Shape of the requested view
+            dtype: Data type of the requested view
+            storage_nbytes: Size of the whole storage, or None if unknown
+
+        Returns:
+            True to fetch the whole storage, False to fetch only the view
+        """
+        if storage_nbytes is None:
+            return True
+
+        dtype_name = dtype.replace("torch.", "")
+        view_nbytes = getattr(torch, dtype_name).itemsize
+        for size in shape:
+            view_nbytes *= size
+
+        return view_nbytes >= self._full_fetch_ratio * storage_nbytes
+
+    def _create_tensor_from_view_bytes(
+        self, raw_bytes: bytes, shape: List[int], dtype: str
+    ) -> torch.Tensor:
+        """
+        Create a CPU tensor from the bytes of a view gathered remotely.
+
+        Args:
+            raw_bytes: View elements packed row-major
+            shape: Shape of the view
+            dtype: Data type of the view
+
+        Returns:
+            Contiguous CPU tensor with the view's shape and dtype
+        """
+        from .._tensor_utils import numpy_bytes_to_cpu_tensor
+
+        dtype_name = dtype.replace("torch.", "")
+        torch_dtype = getattr(torch, dtype_name)
+
+        if len(raw_bytes) == 0:
+            return torch.empty(shape, dtype=torch_dtype)
+        return numpy_bytes_to_cpu_tensor(raw_bytes, tuple(shape), torch_dtype)
+
     # RPC batching helper methods
     def _queue_rpc(
         self,
@@ -353,6 +1022,8 @@ class ClientInterface(ABC):
         kwargs: dict,
         return_future: bool = False,
         invalidate_storage_ids: Optional[List[int]] = None,
+        read_storage_ids: Optional[List[int]] = None,
+        write_storage_ids: Optional[List[int]] = None,
     ) -> Optional[Any]:
         """
         Helper method to queue an RPC for batching.
@@ -364,32 +1035,160 @@ class ClientInterface(ABC):
             kwargs: Keyword arguments for the RPC method
             return_future: Whether to return a Future for this call
             invalidate_storage_ids: Storage IDs to invalidate immediately (at queue time)
+            read_storage_ids: Storage IDs the call reads, if known. A blocking
+                call that only reads is sent with just the calls writing them.
+            write_storage_ids: Storage IDs the call modifies without
+                invalidating cached data (defaults to invalidate_storage_ids)
 
         Returns:
             Future object if return_future=True or call_type="remote", None otherwise
         """
-        # Invalidate cache immediately for storage-modifying operations
-        if invalidate_storage_ids:
-            for storage_id in invalidate_storage_ids:
-                if storage_id in self._storage_cache:
-                    del self._storage_cache[storage_id]
-
-        # Queue the RPC for batching
-        future = self._batch_queue.enqueue_call(
-            call_type=call_type,
-            method_name=method_name,
-            args=args,
-            kwargs=kwargs,
-            return_future=return_future,
-        )
+        # Calls queued on a high-priority stream go out ahead of bulk traffic,
+        # so they never wait for room behind it either
+        priority = self._on_priority_stream()
+
+        # Wait for room in the queue before taking the pack lock, which the
+        # sender needs to drain it
+        if not priority:
+            self._batch_queue.wait_for_capacity(
+                _payload_nbytes(args), self._wake_batch_thread
+            )
 
-        # Wake up background thread immediately for blocking calls to reduce latency
-        if call_type == "remote" or return_future:
-            from .._remote_orchestrator import remote_orchestrator
-            remote_orchestrator.wake_batch_thread_for_blocking_rpc()
+        with self._pack_lock:
+            # Packed uploads go out first so they keep their place in the op
+            # stream. New storages cannot be referenced by them, so creating
+            # one lets the pack keep growing across Module.to() parameters.
+            if method_name != "create_storage":
+                self._flush_packed_uploads()
+
+            # Invalidate cache immediately for storage-modifying operations
+            if invalidate_storage_ids:
+                self.invalidate_multiple_storage_caches(invalidate_storage_ids)
+
+            if write_storage_ids is None:
+                write_storage_ids = invalidate_storage_ids or ()
+
+            # Queue the RPC for batching
+            future = self._batch_queue.enqueue_call(
+                call_type=call_type,
+                method_name=method_name,
+                args=args,
+                kwargs=kwargs,
+                return_future=return_future,
+                writes=tuple(write_storage_ids),
+                reads=None if read_storage_ids is None else tuple(read_storage_ids),
+                priority=priority,
+            )
+
+        # Wake up background thread immediately for blocking and priority
+        # calls to reduce latency. The queue reports them as blocking, so the
+        # sender flushes only what they depend on.
+        if call_type == "remote" or return_future or priority:
+            self._wake_batch_thread()
+        else:
+            # Wake it when a batch starts (to schedule its age deadline) or
+            # once the batch is large enough to send right away
+            calls, nbytes, age, _ = self._pending_state()
+            reason = self._flush_policy.check(calls, nbytes, age, False)
+            if calls == 1 or reason in ("calls", "bytes"):
+                self._wake_batch_thread()
 
         return future
 
+    def _on_priority_stream(self) -> bool:
+        """Check whether the calling thread's current stream is high priority."""
+        from .._device_daemon import driver
+
+        streams = driver.registry_obj
+        if not streams.has_priority_streams():
+            return False
+        if self._device_index is None:
+            from ..device import get_device_registry
+
+            registry = get_device_registry()
+            for machine in registry.get_all_machines():
+                if machine._client is self:
+                    self._device_index = registry.get_device_index(machine)
+            if self._device_index is None:
+                return False
+        return streams.is_priority_stream(self._device_index)
+
+    def _wake_batch_thread(self) -> None:
+        """Have this client's batch sender re-evaluate its flush triggers."""
+        from .._remote_orchestrator import remote_orchestrator
+
+        remote_orchestrator.wake_batch_thread(self)
+
+    def _pending_state(self) -> Tuple[int, int, float, bool]:
+        """
+        Get the work waiting to be sent, including packed uploads.
+
+        Returns:
+            Tuple of (pending calls, pending payload bytes, seconds the oldest
+            pending call or packed upload has waited, whether a caller is
+            waiting on a result)
+        """
+        calls, nbytes, age, blocking = self._batch_queue.pending()
+        with self._pack_lock:
+            if self._pack_entries:
+                calls += len(self._pack_entries)
+                nbytes += self._pack_used
+                age = max(age, time.monotonic() - self._pack_started_at)
+        return calls, nbytes, age, blocking
+
+    def set_flush_policy(
+        self,
+        max_calls: Optional[int] = None,
+        max_bytes: Optional[int] = None,
+        max_age: Optional[float] = None,
+    ) -> None:
+        """
+        Override when this client's queued RPCs are sent.
+
+        Args:
+            max_calls: Pending call count that triggers a flush
+            max_bytes: Pending payload bytes that trigger a flush
+            max_age: Seconds the oldest pending call may wait, or None to
+                adapt it to the observed round-trip time
+        """
+        self._flush_policy.configure(max_calls, max_bytes, max_age)
+        self._wake_batch_thread()
+
+    def get_batch_stats(self) -> Dict[str, Any]:
+        """
+        Get statistics about this client's RPC batching.
+
+        Returns:
+            Queue statistics (including backpressure limits and stalls) with
+            the flush policy and pipeline statistics nested under
+            "flush_policy" and "pipeline"
+        """
+        stats = self._batch_queue.get_stats()
+        stats["flush_policy"] = self._flush_policy.get_stats()
+        stats["pipeline"] = self._batch_pipeline.get_stats()
+        return stats
+
+    def set_queue_limits(
+        self, max_calls: Optional[int] = None, max_bytes: Optional[int] = None
+    ) -> None:
+        """
+        Bound the work queued for this client before producers wait.
+
+        Args:
+            max_calls: Pending call limit, or None for the default
+            max_bytes: Pending payload byte limit, or None for the default
+        """
+        self._batch_queue.set_limits(max_calls, max_bytes)
+
+    def set_batch_window(self, window: int) -> None:
+        """
+        Set how many batches may be in flight to the server at once.
+
+        Args:
+            window: Batches in flight, between 1 and MAX_BATCH_WINDOW
+        """
+        self._batch_pipeline.set_window(window)
+
     def _register_for_batching(self) -> None:
         """Register this client with the orchestrator for batching."""
         if not self._registered_for_batching:
@@ -405,8 +1204,21 @@ class ClientInterface(ABC):
 
             remote_orchestrator.unregister_client_for_batching(self)
             self._registered_for_batching = False
+            self._batch_pipeline.wait_idle()
 
     # Cache invalidation methods (updated for batching timing)
+    def storage_version(self, storage_id: int) -> int:
+        """
+        Get the version of a storage's latest queued write.
+
+        Args:
+            storage_id: Storage ID to query
+
+        Returns:
+            Version number, or 0 if the storage has not been written
+        """
+        return self._storage_versions.get(storage_id, 0)
+
     def invalidate_storage_cache(self, storage_id: int) -> None:
         """
         Invalidate cache entry for a specific storage ID.
@@ -414,26 +1226,44 @@ class ClientInterface(ABC):
         This method should be called whenever a storage has been modified
         on the remote side to ensure cache consistency. With batching,
         invalidation happens at queue time to maintain correct semantics.
+        Only the storage's version is bumped; cached data tagged with an
+        older version is discarded the next time it is looked up.
 
         Args:
             storage_id: Storage ID to invalidate
         """
-        if storage_id in self._storage_cache:
-            del self._storage_cache[storage_id]
+        self._storage_versions[storage_id] = next(self._version_clock)
 
     def invalidate_multiple_storage_caches(self, storage_ids: List[int]) -> None:
         """
         Invalidate cache entries for multiple storage IDs.
 
         This method provides efficient batch invalidation for operations
-        that modify multiple storages.
+        that modify multiple storages; they all move to one new version.
 
         Args:
             storage_ids: List of storage IDs to invalidate
         """
-        for storage_id in storage_ids:
-            if storage_id in self._storage_cache:
-                del self._storage_cache[storage_id]
+        if storage_ids:
+            version = next(self._version_clock)
+            for storage_id in storage_ids:
+                self._storage_versions[storage_id] = version
+
+    def forget_storage(self, storage_id: int) -> None:
+        """
+        Drop all cached state of a storage that is being freed.
+
+        Unlike invalidation this also drops the version, so it must only be
+        called when the storage ID will not be read again before it is
+        reallocated.
+
+        Args:
+            storage_id: Storage ID being freed
+        """
+        with self._cache_lock:
+            self._cache_drop(storage_id)
+        self._storage_versions.pop(storage_id, None)
+        self._chunk_hashes.pop(storage_id, None)
 
     def clear_storage_cache(self) -> None:
         """
@@ -441,25 +1271,159 @@ class ClientInterface(ABC):
 
         This method can be used for cleanup or when the client is stopped.
         """
-        self._storage_cache.clear()
+        with self._cache_lock:
+            self._storage_cache.clear()
+            self._cache_entry_hits.clear()
+            self._cache_bytes = 0
+        self._chunk_hashes.clear()
+
+    def set_cache_limits(
+        self, max_bytes: int, max_entry_bytes: Optional[int] = None
+    ) -> None:
+        """
+        Set the byte budget of the storage cache.
 
-    def get_cache_stats(self) -> Dict[str, int]:
+        Least recently used storages are evicted until the cache fits.
+
+        Args:
+            max_bytes: Total bytes of cached storages (0 disables caching)
+            max_entry_bytes: Storages larger than this are never cached, or
+                None to only bound them by max_bytes
+
+        Raises:
+            ValueError: If a limit is negative
+        """
+        if max_bytes < 0 or (max_entry_bytes is not None and max_entry_bytes < 0):
+            raise ValueError("Cache limits must be non-negative")
+        with self._cache_lock:
+            self._cache_max_bytes = max_bytes
+            self._cache_max_entry_bytes = max_entry_bytes
+            for storage_id, (_, tensor) in list(self._storage_cache.items()):
+                if max_entry_bytes is not None and tensor.nbytes > max_entry_bytes:
+                    self._cache_drop(storage_id)
+                    self._cache_evictions += 1
+            self._evict_to_budget(0)
+
+    def _cache_lookup(self, storage_id: int) -> Optional[torch.Tensor]:
+        """
+        Get a cached storage tensor and mark it most recently used.
+
+        Args:
+            storage_id: Storage ID to look up
+
+        Returns:
+            Cached 1D uint8 CPU tensor, or None on a miss or stale entry
+        """
+        with self._cache_lock:
+            entry = self._storage_cache.get(storage_id)
+            if entry is not None and entry[0] != self.storage_version(storage_id):
+                self._cache_drop(storage_id)
+                self._cache_stale += 1
+                entry = None
+            if entry is None:
+                self._cache_misses += 1
+                return None
+            tensor = entry[1]
+            self._storage_cache.move_to_end(storage_id)
+            self._cache_entry_hits[storage_id] += 1
+            self._cache_hits += 1
+            return tensor
+
+    def _cache_store(
+        self, storage_id: int, tensor: torch.Tensor, version: int
+    ) -> None:
+        """
+        Cache a downloaded storage, evicting LRU entries to stay in budget.
+
+        Storages above the per-storage limit or larger than the whole budget
+        are not cached, nor are downloads overtaken by a write queued while
+        they were in flight.
+
+        Args:
+            storage_id: Storage ID the tensor holds
+            tensor: Underlying 1D uint8 CPU tensor of the whole storage
+            version: Storage version when the download was issued
+        """
+        nbytes = tensor.nbytes
+        if nbytes > self._cache_max_bytes or (
+            self._cache_max_entry_bytes is not None
+            and nbytes > self._cache_max_entry_bytes
+        ):
+            return
+        with self._cache_lock:
+            if version != self.storage_version(storage_id):
+                return
+            self._cache_drop(storage_id)
+            self._evict_to_budget(nbytes)
+            self._storage_cache[storage_id] = (version, tensor)
+            self._cache_entry_hits[storage_id] = 0
+            self._cache_bytes += nbytes
+
+    def _cache_drop(self, storage_id: int) -> None:
+        """Remove a cache entry if present. Caller holds _cache_lock."""
+        entry = self._storage_cache.pop(storage_id, None)
+        if entry is not None:
+            self._cache_bytes -= entry[1].nbytes
+            del self._cache_entry_hits[storage_id]
+
+    def _evict_to_budget(self, incoming_bytes: int) -> None:
+        """Evict LRU entries until incoming_bytes fit. Caller holds _cache_lock."""
+        while (
+            self._storage_cache
+            and self._cache_bytes + incoming_bytes > self._cache_max_bytes
+        ):
+            storage_id = next(iter(self._storage_cache))
+            self._cache_drop(storage_id)
+            self._cache_evictions += 1
+
+    def get_cache_stats(self) -> Dict[str, Any]:
         """
         Get cache statistics for debugging and monitoring.
 
         Returns:
-            Dictionary with cache statistics
+            Dictionary with cache statistics, including cached bytes against
+            the budget, evictions, and hit counts per cached storage
         """
-        total_requests = self._cache_hits + self._cache_misses
-        hit_rate = self._cache_hits / total_requests if total_requests > 0 else 0.0
+        with self._cache_lock:
+            total_requests = self._cache_hits + self._cache_misses
+            hit_rate = (
+                self._cache_hits / total_requests if total_requests > 0 else 0.0
+            )
 
-        return {
-            "cache_size": len(self._storage_cache),
-            "cache_hits": self._cache_hits,
-            "cache_misses": self._cache_misses,
-            "hit_rate": hit_rate,
-            "total_requests": total_requests,
-        }
+            return {
+                "cache_size": len(self._storage_cache),
+                "cache_bytes": self._cache_bytes,
+                "max_bytes": self._cache_max_bytes,
+                "max_entry_bytes": self._cache_max_entry_bytes,
+                "cache_hits": self._cache_hits,
+                "cache_misses": self._cache_misses,
+                "cache_evictions": self._cache_evictions,
+                "cache_stale": self._cache_stale,
+                "hit_rate": hit_rate,
+                "total_requests": total_requests,
+                "entry_hits": dict(self._cache_entry_hits),
+            }
+
+    def get_transfer_stats(self) -> Dict[str, Any]:
+        """
+        Get storage transfer statistics, including compression.
+
+        Returns:
+            Dictionary with raw and on-the-wire bytes and achieved compression
+            ratio per direction, how often each codec was used, and upload
+            deduplication hits, misses and bytes saved
+        """
+        with self._transfer_stats_lock:
+            stats: Dict[str, Any] = {}
+            for direction, counts in self._transfer_stats.items():
+                raw = counts["raw_bytes"]
+                stats[direction] = {
+                    **counts,
+                    "ratio": counts["wire_bytes"] / raw if raw > 0 else 1.0,
+                }
+            stats["codecs"] = dict(self._codec_counts)
+            stats["dedup"] = dict(self._dedup_stats)
+        return stats
 
     # Context manager methods (optional to override, but provide default behavior)
     def __enter__(self):
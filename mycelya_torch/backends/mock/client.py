@@ -8,13 +8,15 @@ This module provides the MockClient class that uses Modal's .local() execution
 for development and testing without requiring remote cloud resources.
 """
 
-from typing import Any, Dict, List, Optional, Union
+from concurrent.futures import Future
+from typing import Any, Dict, List, Optional, Tuple, Union
 
 import torch
 
 from _mycelya_torch_modal.modal_app import create_modal_app_for_gpu
 
 from ..._logging import get_logger
+from ..._transport import InProcessTransport, Transport
 from ..client_interface import ClientInterface
 
 log = get_logger(__name__)
@@ -53,6 +55,22 @@ class MockClient(ClientInterface):
             self.gpu_type, self.machine_id, self.timeout, self.retries
         )
 
+    def _create_transport(self) -> Transport:
+        """Pass payloads by reference to the in-process server."""
+        return InProcessTransport()
+
+    def set_transport_compression(self, enabled: bool) -> None:
+        """
+        Compress transfers to the in-process server like a network transport.
+
+        Mock transfers are passed by reference and never compressed by
+        default; enabling this exercises the codecs end to end.
+
+        Args:
+            enabled: Whether payloads are compressed when it pays off
+        """
+        self._transport = InProcessTransport(compression=enabled)
+
     def start(self):
         """Start the mock execution environment."""
         if not self._is_running:
@@ -114,10 +132,14 @@ class MockClient(ClientInterface):
         target_stride: List[int],
         target_storage_offset: int,
         target_dtype: str,
+        non_blocking: bool = False,
     ) -> None:
         """
         Update an existing storage with storage tensor data using mock execution.
 
+        Mock execution is synchronous, so non_blocking uploads complete before
+        this returns.
+
         Args:
             storage_id: Storage ID to update
             storage_tensor: CPU tensor wrapping the storage data
@@ -129,6 +151,7 @@ class MockClient(ClientInterface):
             target_stride: Stride of the target view in storage
             target_storage_offset: Storage offset of the target view in storage
             target_dtype: Data type of the target view in storage
+            non_blocking: Accepted for interface compatibility
 
         Returns:
             None
@@ -138,10 +161,31 @@ class MockClient(ClientInterface):
                 f"Machine {self.machine_id} is not running. Call start() first."
             )
 
-        # Serialize storage tensor using numpy approach (same as Modal client)
-        from ..._tensor_utils import cpu_tensor_to_numpy_bytes
+        from ..._tensor_utils import DELTA_CHUNK_BYTES, cpu_tensor_to_host_buffer
+
+        # Send large uploads as deltas and pack small ones the same way as the
+        # Modal client; packed uploads are applied before any other server call
+        byte_offset = self._streamable_upload_offset(
+            source_shape,
+            source_dtype,
+            target_shape,
+            target_stride,
+            target_storage_offset,
+            target_dtype,
+        )
+        nbytes = storage_tensor.numel() * storage_tensor.element_size()
+        if byte_offset is not None and nbytes < DELTA_CHUNK_BYTES:
+            self._pack_upload(storage_id, storage_tensor, byte_offset)
+            return None
+
+        self._flush_packed_uploads()
+        if byte_offset is not None:
+            self._upload_storage_range(storage_id, storage_tensor, byte_offset)
+            return None
 
-        numpy_bytes = cpu_tensor_to_numpy_bytes(storage_tensor)
+        # The in-process transport hands the server a memoryview over the
+        # tensor memory, so nothing is serialized
+        payload = self._encode_upload_payload(cpu_tensor_to_host_buffer(storage_tensor))
 
         # Invalidate cache immediately since this modifies storage
         self.invalidate_storage_cache(storage_id)
@@ -149,7 +193,7 @@ class MockClient(ClientInterface):
         # Execute using .local() instead of queuing for remote execution
         self._server_instance.update_storage.local(
             storage_id,
-            numpy_bytes,
+            payload,
             source_shape,
             source_stride,
             source_storage_offset,
@@ -160,26 +204,143 @@ class MockClient(ClientInterface):
             target_dtype,
         )
 
+    def _write_storage_bytes(
+        self, storage_id: int, byte_offset: int, payload: Any
+    ) -> None:
+        """
+        Write one chunk of a streamed upload using mock execution.
+
+        Args:
+            storage_id: The storage ID to write into
+            byte_offset: Byte offset of the chunk within the storage
+            payload: Memoryview over the chunk from the in-process transport
+
+        Returns:
+            None
+        """
+        self.invalidate_storage_cache(storage_id)
+        self._server_instance.write_storage_bytes.local(
+            storage_id, byte_offset, payload
+        )
+
+    def _write_storages_packed(
+        self, entries: List[Tuple[int, int, int, int]], payload: Any
+    ) -> None:
+        """
+        Scatter a packed multi-tensor upload using mock execution.
+
+        Args:
+            entries: (storage_id, byte_offset, payload_offset, nbytes) per tensor
+            payload: Memoryview over the packed bytes from the in-process transport
+        """
+        self._server_instance.write_storages_packed.local(entries, payload)
+
+    def _write_storage_from_blob(
+        self, storage_id: int, byte_offset: int, digest: str, nbytes: int
+    ) -> Future:
+        """
+        Fill a storage byte range from the blob store using mock execution.
+
+        Args:
+            storage_id: The storage ID to write into
+            byte_offset: Byte offset of the range within the storage
+            digest: Content hash of the bytes
+            nbytes: Number of bytes in the range
+
+        Returns:
+            Completed Future holding True if the blob was found
+        """
+        future = Future()
+        try:
+            self.invalidate_storage_cache(storage_id)
+            future.set_result(
+                self._server_instance.write_storage_from_blob.local(
+                    storage_id, byte_offset, digest, nbytes
+                )
+            )
+        except Exception as e:
+            future.set_exception(e)
+        return future
+
+    def _save_storage_blob(
+        self, storage_id: int, byte_offset: int, nbytes: int, digest: str
+    ) -> None:
+        """
+        Save a storage byte range to the blob store using mock execution.
+
+        Args:
+            storage_id: The storage ID to read from
+            byte_offset: Byte offset of the range within the storage
+            nbytes: Number of bytes in the range
+            digest: Content hash of the bytes
+        """
+        self._server_instance.save_storage_blob.local(
+            storage_id, byte_offset, nbytes, digest
+        )
+
+    def _read_storage_bytes_async(
+        self, storage_id: int, byte_offset: int, nbytes: int
+    ) -> Future:
+        """
+        Read one chunk of a streamed download using mock execution.
+
+        Args:
+            storage_id: The storage ID to read from
+            byte_offset: Byte offset of the chunk within the storage
+            nbytes: Number of bytes to read
+
+        Returns:
+            Completed Future holding the decompressed chunk bytes
+        """
+        self._flush_packed_uploads()
+        future = Future()
+        try:
+            payload = self._server_instance.read_storage_bytes.local(
+                storage_id, byte_offset, nbytes, **self._download_kwargs()
+            )
+            future.set_result(self._decode_download_payload(payload))
+        except Exception as e:
+            future.set_exception(e)
+        return future
+
     def _get_storage_data(
         self,
         storage_id: int,
+        shape: Optional[List[int]] = None,
+        stride: Optional[List[int]] = None,
+        storage_offset: int = 0,
+        dtype: Optional[str] = None,
     ) -> bytes:
         """
         Get raw storage data by ID using mock execution.
 
         Args:
             storage_id: The storage ID
+            shape: Shape of the view to gather, or None for the whole storage
+            stride: Stride of the view to gather
+            storage_offset: Storage offset of the view to gather
+            dtype: Data type of the view to gather
 
         Returns:
-            Raw untyped storage bytes
+            Raw bytes of the storage or of the gathered view
         """
         if not self.is_running():
             raise RuntimeError(
                 f"Machine {self.machine_id} is not running. Call start() first."
             )
 
+        self._flush_packed_uploads()
+
         # Execute using .local() instead of remote call
-        raw_bytes = self._server_instance.get_storage_data.local(storage_id)
+        payload = self._server_instance.get_storage_data.local(
+            storage_id,
+            shape,
+            stride,
+            storage_offset,
+            dtype,
+            **self._download_kwargs(),
+        )
+        raw_bytes = self._decode_download_payload(payload)
 
         # Return raw bytes directly - no deserialization needed
         return raw_bytes
@@ -202,8 +363,7 @@ class MockClient(ClientInterface):
                 f"Machine {self.machine_id} is not running. Call start() first."
             )
 
-        # Execute using .local() instead of remote call
-        raw_bytes = self._server_instance.get_storage_data.local(storage_id)
+        raw_bytes = self._get_storage_data(storage_id)
 
         if raw_bytes is None:
             raise RuntimeError(
@@ -231,6 +391,8 @@ class MockClient(ClientInterface):
                 f"Machine {self.machine_id} is not running. Call start() first."
             )
 
+        self._flush_packed_uploads()
+
         # Invalidate cache immediately since this modifies storage
         self.invalidate_storage_cache(storage_id)
 
@@ -252,8 +414,10 @@ class MockClient(ClientInterface):
                 f"Machine {self.machine_id} is not running. Call start() first."
             )
 
-        # Invalidate cache immediately since this removes storage
-        self.invalidate_storage_cache(storage_id)
+        self._flush_packed_uploads()
+
+        # Drop cached state immediately since the ID may be reused right away
+        self.forget_storage(storage_id)
 
         # Execute using .local() instead of remote call
         self._server_instance.remove_storage.local(storage_id)
@@ -267,6 +431,8 @@ class MockClient(ClientInterface):
         args: List[Any],
         kwargs: Dict[str, Any],
         return_metadata: bool = False,
+        rng_state: Optional[Dict[str, int]] = None,
+        mutated_storage_ids: Optional[List[int]] = None,
     ) -> Optional[List[Dict[str, Any]]]:
         """
         Execute an aten operation using mock execution.
@@ -278,6 +444,9 @@ class MockClient(ClientInterface):
             args: Operation arguments
             kwargs: Operation keyword arguments
             return_metadata: If True, return output tensor metadata instead of None
+            rng_state: Philox seed/offset for random operations, None otherwise
+            mutated_storage_ids: Storage IDs of inputs the op writes in place
+                without returning them
 
         Returns:
             None for normal operations, or List[Dict] of output tensor metadata if return_metadata=True
@@ -293,8 +462,13 @@ class MockClient(ClientInterface):
         log.info(f"📡 Mock Client sending Input Storage IDs: {input_storage_ids}")
         log.info(f"📡 Mock Client sending Output Storage IDs: {output_storage_ids}")
 
+        self._flush_packed_uploads()
+
         # Invalidate cache immediately for storage IDs that will be modified
         modified_storage_ids = [sid for sid in output_storage_ids if sid is not None]
+        modified_storage_ids += [
+            sid for sid in mutated_storage_ids or () if sid not in modified_storage_ids
+        ]
         self.invalidate_multiple_storage_caches(modified_storage_ids)
 
         # Execute using .local() instead of remote call
@@ -305,6 +479,7 @@ class MockClient(ClientInterface):
             args,
             kwargs,
             return_metadata,
+            rng_state,
         )
 
         if return_metadata:
@@ -8,7 +8,8 @@ This module provides the ModalClient class for interfacing with Modal cloud GPUs
 along with related functionality for creating and managing Modal applications.
 """
 
-from typing import Any, Dict, List, Optional, Union
+from concurrent.futures import Future
+from typing import Any, Dict, List, Optional, Tuple, Union
 
 import torch
 
@@ -107,6 +108,8 @@ class ModalClient(ClientInterface):
                 call_type="spawn",
                 args=(storage_id, nbytes),
                 kwargs={},
+                read_storage_ids=[],
+                write_storage_ids=[storage_id],
             )
         except Exception as e:
             raise RuntimeError(f"Failed to create storage {storage_id}: {e}") from e
@@ -123,7 +126,8 @@ class ModalClient(ClientInterface):
         target_stride: List[int],
         target_storage_offset: int,
         target_dtype: str,
-    ) -> None:
+        non_blocking: bool = False,
+    ) -> Optional[Future]:
         """
         Update an existing storage with storage tensor data.
 
@@ -138,29 +142,63 @@ class ModalClient(ClientInterface):
             target_stride: Stride of the target view in storage
             target_storage_offset: Storage offset of the target view in storage
             target_dtype: Data type of the target view in storage
+            non_blocking: If True, stage the source on the copy worker pool
 
         Returns:
-            None
+            Future resolved once the write is applied if non_blocking, None otherwise
         """
         if not self.is_running():
             raise RuntimeError(
                 f"Machine {self.machine_id} is not running. Call start() first."
             )
 
-        # Serialize storage tensor using numpy approach
-        from ..._tensor_utils import cpu_tensor_to_numpy_bytes
+        from ..._tensor_utils import (
+            DELTA_CHUNK_BYTES,
+            AsyncHostCopy,
+            cpu_tensor_to_host_buffer,
+        )
 
-        # Serialize tensor using numpy approach
-        numpy_bytes = cpu_tensor_to_numpy_bytes(storage_tensor)
+        # Blocking uploads that can be written as a storage byte range: large
+        # ones send only the chunks that changed since the last upload,
+        # streaming big runs straight from the caller's memory; small ones are
+        # packed together and sent as one payload before the next RPC
+        byte_offset = None
+        if not non_blocking:
+            byte_offset = self._streamable_upload_offset(
+                source_shape,
+                source_dtype,
+                target_shape,
+                target_stride,
+                target_storage_offset,
+                target_dtype,
+            )
+        if byte_offset is not None:
+            nbytes = storage_tensor.numel() * storage_tensor.element_size()
+            if nbytes >= DELTA_CHUNK_BYTES:
+                self._upload_storage_range(storage_id, storage_tensor, byte_offset)
+            else:
+                self._pack_upload(storage_id, storage_tensor, byte_offset)
+            return None
+
+        # Otherwise tensor memory is pickled from a buffer view, compressed when
+        # it pays off. Blocking uploads snapshot the source since the batch is
+        # sent after this returns; non-blocking uploads are staged and
+        # compressed off-thread, resolved when the batch is sent.
+        if non_blocking:
+            payload = AsyncHostCopy(storage_tensor, encode=self._encode_upload_payload)
+        else:
+            payload = self._encode_upload_payload(
+                cpu_tensor_to_host_buffer(storage_tensor, snapshot=True)
+            )
 
         # Queue the RPC for batching (fire-and-forget)
         # Invalidate cache immediately since this modifies storage
-        self._queue_rpc(
+        return self._queue_rpc(
             method_name="update_storage",
             call_type="spawn",
             args=(
                 storage_id,
-                numpy_bytes,
+                payload,
                 source_shape,
                 source_stride,
                 source_storage_offset,
@@ -171,33 +209,228 @@ class ModalClient(ClientInterface):
                 target_dtype,
             ),
             kwargs={},
+            return_future=non_blocking,
             invalidate_storage_ids=[storage_id],
+            read_storage_ids=[],
         )
 
-    def _get_storage_data(
+    def _get_storage_data_async(
         self,
         storage_id: int,
-    ) -> bytes:
+        shape: Optional[List[int]] = None,
+        stride: Optional[List[int]] = None,
+        storage_offset: int = 0,
+        dtype: Optional[str] = None,
+    ) -> Future:
         """
-        Get raw storage data by ID.
+        Queue a storage data download without waiting for it.
 
         Args:
             storage_id: The storage ID
+            shape: Shape of the view to gather, or None for the whole storage
+            stride: Stride of the view to gather
+            storage_offset: Storage offset of the view to gather
+            dtype: Data type of the view to gather
 
         Returns:
-            Raw untyped storage bytes
+            Future resolving to the raw bytes of the storage or view
         """
         if not self.is_running():
             raise RuntimeError(
                 f"Machine {self.machine_id} is not running. Call start() first."
             )
 
-        # Queue the RPC for batching (blocking call that returns raw bytes)
-        future = self._queue_rpc(
+        # Only send view parameters when gathering a view
+        kwargs = self._download_kwargs()
+        if shape is not None:
+            kwargs.update(
+                shape=shape,
+                stride=stride,
+                storage_offset=storage_offset,
+                dtype=dtype,
+            )
+
+        rpc_future = self._queue_rpc(
             method_name="get_storage_data",
             call_type="remote",
             args=(storage_id,),
+            kwargs=kwargs,
+            read_storage_ids=[storage_id],
+        )
+        return self._decoded_future(rpc_future)
+
+    def _decoded_future(self, rpc_future: Future) -> Future:
+        """Chain a Future that decompresses a download response on arrival."""
+        result = Future()
+
+        def _on_response(done: Future) -> None:
+            try:
+                result.set_result(self._decode_download_payload(done.result()))
+            except Exception as e:
+                result.set_exception(e)
+
+        rpc_future.add_done_callback(_on_response)
+        return result
+
+    def _write_storage_bytes(
+        self, storage_id: int, byte_offset: int, payload: Any
+    ) -> Optional[Future]:
+        """
+        Queue one chunk of a streamed upload.
+
+        Args:
+            storage_id: The storage ID to write into
+            byte_offset: Byte offset of the chunk within the storage
+            payload: HostBuffer over the chunk, or a (codec, data) tuple
+
+        Returns:
+            Future resolved once the chunk is applied on the server
+        """
+        if not self.is_running():
+            raise RuntimeError(
+                f"Machine {self.machine_id} is not running. Call start() first."
+            )
+
+        return self._queue_rpc(
+            method_name="write_storage_bytes",
+            call_type="spawn",
+            args=(storage_id, byte_offset, payload),
             kwargs={},
+            return_future=True,
+            invalidate_storage_ids=[storage_id],
+            read_storage_ids=[],
+        )
+
+    def _write_storages_packed(
+        self, entries: List[Tuple[int, int, int, int]], payload: Any
+    ) -> None:
+        """
+        Queue a packed multi-tensor upload (fire-and-forget).
+
+        Args:
+            entries: (storage_id, byte_offset, payload_offset, nbytes) per tensor
+            payload: HostBuffer over the packed bytes, or a (codec, data) tuple
+        """
+        if not self.is_running():
+            raise RuntimeError(
+                f"Machine {self.machine_id} is not running. Call start() first."
+            )
+
+        self._queue_rpc(
+            method_name="write_storages_packed",
+            call_type="spawn",
+            args=(entries, payload),
+            kwargs={},
+            read_storage_ids=[],
+            write_storage_ids=[entry[0] for entry in entries],
+        )
+
+    def _write_storage_from_blob(
+        self, storage_id: int, byte_offset: int, digest: str, nbytes: int
+    ) -> Future:
+        """
+        Queue a blob store lookup that fills a storage byte range on a hit.
+
+        Args:
+            storage_id: The storage ID to write into
+            byte_offset: Byte offset of the range within the storage
+            digest: Content hash of the bytes
+            nbytes: Number of bytes in the range
+
+        Returns:
+            Future resolving to True if the blob was found, False otherwise
+        """
+        if not self.is_running():
+            raise RuntimeError(
+                f"Machine {self.machine_id} is not running. Call start() first."
+            )
+
+        return self._queue_rpc(
+            method_name="write_storage_from_blob",
+            call_type="remote",
+            args=(storage_id, byte_offset, digest, nbytes),
+            kwargs={},
+            invalidate_storage_ids=[storage_id],
+            read_storage_ids=[],
+        )
+
+    def _save_storage_blob(
+        self, storage_id: int, byte_offset: int, nbytes: int, digest: str
+    ) -> None:
+        """
+        Queue saving a storage byte range to the server's blob store.
+
+        Args:
+            storage_id: The storage ID to read from
+            byte_offset: Byte offset of the range within the storage
+            nbytes: Number of bytes in the range
+            digest: Content hash of the bytes
+        """
+        if not self.is_running():
+            raise RuntimeError(
+                f"Machine {self.machine_id} is not running. Call start() first."
+            )
+
+        self._queue_rpc(
+            method_name="save_storage_blob",
+            call_type="spawn",
+            args=(storage_id, byte_offset, nbytes, digest),
+            kwargs={},
+            read_storage_ids=[storage_id],
+        )
+
+    def _read_storage_bytes_async(
+        self, storage_id: int, byte_offset: int, nbytes: int
+    ) -> Future:
+        """
+        Queue a read of one chunk of a streamed download.
+
+        Args:
+            storage_id: The storage ID to read from
+            byte_offset: Byte offset of the chunk within the storage
+            nbytes: Number of bytes to read
+
+        Returns:
+            Future resolving to the decompressed chunk bytes
+        """
+        if not self.is_running():
+            raise RuntimeError(
+                f"Machine {self.machine_id} is not running. Call start() first."
+            )
+
+        rpc_future = self._queue_rpc(
+            method_name="read_storage_bytes",
+            call_type="remote",
+            args=(storage_id, byte_offset, nbytes),
+            kwargs=self._download_kwargs(),
+            read_storage_ids=[storage_id],
+        )
+        return self._decoded_future(rpc_future)
+
+    def _get_storage_data(
+        self,
+        storage_id: int,
+        shape: Optional[List[int]] = None,
+        stride: Optional[List[int]] = None,
+        storage_offset: int = 0,
+        dtype: Optional[str] = None,
+    ) -> bytes:
+        """
+        Get raw storage data by ID.
+
+        Args:
+            storage_id: The storage ID
+            shape: Shape of the view to gather, or None for the whole storage
+            stride: Stride of the view to gather
+            storage_offset: Storage offset of the view to gather
+            dtype: Data type of the view to gather
+
+        Returns:
+            Raw bytes of the storage or of the gathered view
+        """
+        # Queue the RPC for batching (blocking call that returns raw bytes)
+        future = self._get_storage_data_async(
+            storage_id, shape, stride, storage_offset, dtype
         )
 
         # Wait for the result from the Future
@@ -228,20 +461,7 @@ class ModalClient(ClientInterface):
                 f"Machine {self.machine_id} is not running. Call start() first."
             )
 
-        # Queue the RPC for batching (blocking call that returns raw bytes)
-        future = self._queue_rpc(
-            method_name="get_storage_data",
-            call_type="remote",
-            args=(storage_id,),
-            kwargs={},
-        )
-
-        # Wait for the result from the Future
-        raw_bytes = future.result() if future else None
-        if raw_bytes is None:
-            raise RuntimeError(
-                f"Failed to retrieve storage data for storage {storage_id}"
-            )
+        raw_bytes = self._get_storage_data(storage_id)
 
         # Create 1D uint8 tensor directly from raw bytes for caching
         from ..._tensor_utils import numpy_bytes_to_cpu_tensor
@@ -272,6 +492,7 @@ class ModalClient(ClientInterface):
             args=(storage_id, nbytes),
             kwargs={},
             invalidate_storage_ids=[storage_id],
+            read_storage_ids=[storage_id],
         )
 
     def remove_storage(self, storage_id: int) -> None:
@@ -289,14 +510,17 @@ class ModalClient(ClientInterface):
                 f"Machine {self.machine_id} is not running. Call start() first."
             )
 
+        # Drop cached state immediately since the ID may be reused right away
+        self.forget_storage(storage_id)
+
         # Queue the RPC for batching (fire-and-forget)
-        # Invalidate cache immediately since this removes storage
         self._queue_rpc(
             method_name="remove_storage",
             call_type="spawn",
             args=(storage_id,),
             kwargs={},
-            invalidate_storage_ids=[storage_id],
+            read_storage_ids=[],
+            write_storage_ids=[storage_id],
         )
 
     # Operation execution methods
@@ -308,6 +532,8 @@ class ModalClient(ClientInterface):
         args: List[Any],
         kwargs: Dict[str, Any],
         return_metadata: bool = False,
+        rng_state: Optional[Dict[str, int]] = None,
+        mutated_storage_ids: Optional[List[int]] = None,
     ) -> Optional[List[Dict[str, Any]]]:
         """
         Execute an aten operation with separated input metadata and output storage IDs.
@@ -319,6 +545,9 @@ class ModalClient(ClientInterface):
             args: Operation arguments
             kwargs: Operation keyword arguments
             return_metadata: If True, return output tensor metadata instead of None
+            rng_state: Philox seed/offset for random operations, None otherwise
+            mutated_storage_ids: Storage IDs of inputs the op writes in place
+                without returning them
 
         Returns:
             None for normal operations, or List[Dict] of output tensor metadata if return_metadata=True
@@ -334,9 +563,16 @@ class ModalClient(ClientInterface):
         log.info(f"📡 Modal Client sending Input Storage IDs: {input_storage_ids}")
         log.info(f"📡 Modal Client sending Output Storage IDs: {output_storage_ids}")
 
-        # Determine which storage IDs will be modified by this operation
-        # Filter out None values for cache invalidation
+        # Determine which storage IDs will be modified by this operation:
+        # its outputs and any inputs it mutates in place without returning
         modified_storage_ids = [sid for sid in output_storage_ids if sid is not None]
+        modified_storage_ids += [
+            sid for sid in mutated_storage_ids or () if sid not in modified_storage_ids
+        ]
+
+        # Random ops carry their reserved Philox range so the server RNG matches
+        # the client-side generator regardless of how calls are batched
+        rpc_kwargs = {} if rng_state is None else {"rng_state": rng_state}
 
         if return_metadata:
             # Use remote call type to get return value when metadata is needed
@@ -345,8 +581,9 @@ class ModalClient(ClientInterface):
                 method_name="execute_aten_operation",
                 call_type="remote",
                 args=(op_name, input_tensor_metadata, output_storage_ids, args, kwargs),
-                kwargs={"return_metadata": True},
+                kwargs={**rpc_kwargs, "return_metadata": True},
                 invalidate_storage_ids=modified_storage_ids,
+                read_storage_ids=input_storage_ids,
             )
             # Wait for the result from the Future
             return future.result() if future else None
@@ -356,8 +593,9 @@ class ModalClient(ClientInterface):
                 method_name="execute_aten_operation",
                 call_type="spawn",
                 args=(op_name, input_tensor_metadata, output_storage_ids, args, kwargs),
-                kwargs={},
+                kwargs=rpc_kwargs,
                 invalidate_storage_ids=modified_storage_ids,
+                read_storage_ids=input_storage_ids,
             )
             return None
 
@@ -7,6 +7,8 @@
 #include <c10/core/Device.h>
 #include <random>
 #include <string>
+#include <utility>
+#include <vector>
 #include <torch/csrc/utils/pybind.h>
 
 namespace remote {
@@ -35,4 +37,40 @@ at::Tensor empty_strided_remote(at::IntArrayRef size, at::IntArrayRef stride,
 // Utility functions for storage ID management
 bool validate_device_index(c10::DeviceIndex device_index);
 
+// Pinned host staging allocator used for pin_memory() and upload staging
+at::Allocator *get_host_staging_allocator();
+bool is_host_staging_ptr(const void *ptr);
+void host_staging_empty_cache();
+py::dict host_staging_stats();
+
+// Async staging copies for non_blocking uploads: returns (staging, ticket)
+std::pair<at::Tensor, int64_t> host_copy_async(const at::Tensor &src);
+void host_copy_wait(int64_t ticket);
+bool host_copy_query(int64_t ticket);
+
+// Hash each chunk_bytes-sized chunk of a contiguous CPU tensor's bytes
+at::Tensor hash_chunks(const at::Tensor &data, int64_t chunk_bytes);
+
+// Lock-free MPSC queues of RPC call records, addressed by integer handles.
+// Records are owned references passed through untouched: push takes one
+// over, drain and free hand them back in submission order.
+struct RpcQueueState {
+  int64_t pending_calls;
+  int64_t pending_bytes;
+  double oldest_age; // seconds the oldest pending call has waited
+  bool blocking;     // whether a pending call has a caller waiting on it
+  int64_t queued_calls;
+  int64_t drained_calls;
+};
+int64_t rpc_queue_new();
+std::vector<PyObject *> rpc_queue_free(int64_t handle);
+void rpc_queue_push(int64_t handle, PyObject *record, int64_t nbytes,
+                    bool blocking);
+std::vector<PyObject *> rpc_queue_drain(int64_t handle);
+RpcQueueState rpc_queue_state(int64_t handle);
+
+// Reserve Philox counters on a remote generator, returning (seed, offset)
+std::pair<uint64_t, uint64_t> philox_engine_inputs(const at::Generator &gen,
+                                                   uint64_t increment);
+
 } // namespace remote
\ No newline at end of file
@@ -0,0 +1,97 @@
+// Copyright (C) 2025 alyxya
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+#include "Remote.h"
+
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace remote {
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t mix_round(uint64_t acc, uint64_t input) {
+  acc += input * kPrime2;
+  return rotl(acc, 31) * kPrime1;
+}
+
+// XXH64-style hash. The main loop keeps four independent accumulators over
+// 32-byte stripes so it pipelines (and vectorizes) at memory bandwidth. Only
+// used to detect changed chunks, so it need not match reference XXH64.
+uint64_t hash_bytes(const uint8_t *data, size_t len) {
+  const uint8_t *p = data;
+  const uint8_t *const end = data + len;
+
+  uint64_t lanes[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+  while (end - p >= 32) {
+    uint64_t words[4];
+    std::memcpy(words, p, sizeof(words));
+    for (int i = 0; i < 4; i++) {
+      lanes[i] = mix_round(lanes[i], words[i]);
+    }
+    p += 32;
+  }
+
+  uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) +
+               rotl(lanes[3], 18);
+  h += static_cast<uint64_t>(len);
+
+  while (end - p >= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    h ^= mix_round(0, word);
+    h = rotl(h, 27) * kPrime1 + kPrime4;
+    p += 8;
+  }
+  while (p < end) {
+    h ^= static_cast<uint64_t>(*p) * kPrime3;
+    h = rotl(h, 11) * kPrime1;
+    p++;
+  }
+
+  // Final avalanche
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+} // namespace
+
+at::Tensor hash_chunks(const at::Tensor &data, int64_t chunk_bytes) {
+  TORCH_CHECK(data.device().is_cpu(), "hash_chunks requires a CPU tensor");
+  TORCH_CHECK(data.is_contiguous(), "hash_chunks requires a contiguous tensor");
+  TORCH_CHECK(chunk_bytes > 0, "chunk_bytes must be positive, got ",
+              chunk_bytes);
+
+  const int64_t nbytes = data.numel() * data.element_size();
+  const int64_t num_chunks = (nbytes + chunk_bytes - 1) / chunk_bytes;
+  at::Tensor hashes = at::empty({num_chunks}, at::kLong);
+  if (num_chunks == 0) {
+    return hashes;
+  }
+
+  const auto *base = static_cast<const uint8_t *>(data.data_ptr());
+  auto *out = hashes.data_ptr<int64_t>();
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      int64_t offset = i * chunk_bytes;
+      size_t len = static_cast<size_t>(std::min(chunk_bytes, nbytes - offset));
+      out[i] = static_cast<int64_t>(hash_bytes(base + offset, len));
+    }
+  });
+  return hashes;
+}
+
+} // namespace remote
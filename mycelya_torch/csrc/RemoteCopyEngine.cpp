@@ -0,0 +1,151 @@
+// Copyright (C) 2025 alyxya
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+#include "Remote.h"
+
+#include <ATen/EmptyTensor.h>
+#include <ATen/core/grad_mode.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+namespace remote {
+namespace {
+
+// Worker pool that stages host tensors for non_blocking uploads. Each job
+// packs the source into a pinned staging buffer off the calling thread (and
+// without the GIL), so tensor.to("mycelya", non_blocking=True) returns
+// immediately and the RPC sender only waits for the copy when it serializes.
+class HostCopyEngine {
+public:
+  HostCopyEngine() {
+    size_t num_workers = 2;
+    if (const char *env = std::getenv("MYCELYA_COPY_THREADS")) {
+      num_workers = std::max(1, std::atoi(env));
+    }
+    for (size_t i = 0; i < num_workers; i++) {
+      workers_.emplace_back([this] { worker_loop(); });
+    }
+  }
+
+  std::pair<at::Tensor, int64_t> submit(const at::Tensor &src) {
+    TORCH_CHECK(src.device().is_cpu(),
+                "Async host copies require a CPU source tensor");
+
+    constexpr c10::DispatchKeySet cpu_dks(c10::DispatchKey::CPU);
+    at::Tensor dst = at::detail::empty_generic(
+        src.sizes(), get_host_staging_allocator(), cpu_dks, src.scalar_type(),
+        c10::nullopt);
+
+    std::packaged_task<void()> task([dst, src]() mutable {
+      at::NoGradGuard no_grad;
+      dst.copy_(src);
+    });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t ticket = next_ticket_++;
+    pending_[ticket] = task.get_future().share();
+    jobs_.push_back(std::move(task));
+    cv_.notify_one();
+    return std::make_pair(dst, ticket);
+  }
+
+  // Block until the copy for ticket finishes, rethrowing any copy error
+  void wait(int64_t ticket) {
+    std::shared_future<void> done;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = pending_.find(ticket);
+      if (it == pending_.end()) {
+        return;
+      }
+      done = it->second;
+    }
+    done.wait();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_.erase(ticket);
+    }
+    done.get();
+  }
+
+  bool query(int64_t ticket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pending_.find(ticket);
+    return it == pending_.end() ||
+           it->second.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+  }
+
+private:
+  void worker_loop() {
+    while (true) {
+      std::packaged_task<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !jobs_.empty(); });
+        task = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::packaged_task<void()>> jobs_;
+  std::unordered_map<int64_t, std::shared_future<void>> pending_;
+  int64_t next_ticket_ = 1;
+  std::vector<std::thread> workers_;
+};
+
+// Intentionally leaked: workers run for the lifetime of the process. A forked
+// child (e.g. a DataLoader worker) inherits none of the worker threads and may
+// inherit a mutex locked mid-copy, so it abandons the parent's engine and
+// builds its own on first use. Windows has no fork.
+std::mutex *engine_mutex = new std::mutex();
+HostCopyEngine *engine = nullptr;
+
+#ifndef _WIN32
+void reset_engine_after_fork() {
+  engine_mutex = new std::mutex();
+  engine = nullptr;
+}
+#endif
+
+HostCopyEngine &copy_engine() {
+#ifndef _WIN32
+  static const int registered =
+      pthread_atfork(nullptr, nullptr, reset_engine_after_fork);
+  (void)registered;
+#endif
+  std::lock_guard<std::mutex> lock(*engine_mutex);
+  if (engine == nullptr) {
+    engine = new HostCopyEngine();
+  }
+  return *engine;
+}
+
+} // namespace
+
+std::pair<at::Tensor, int64_t> host_copy_async(const at::Tensor &src) {
+  return copy_engine().submit(src);
+}
+
+void host_copy_wait(int64_t ticket) { copy_engine().wait(ticket); }
+
+bool host_copy_query(int64_t ticket) { return copy_engine().query(ticket); }
+
+} // namespace remote
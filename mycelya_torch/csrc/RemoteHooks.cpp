@@ -3,7 +3,7 @@
 
 #include "Remote.h"
 
-#include <ATen/CPUGeneratorImpl.h>
+#include <ATen/core/Generator.h>
 #include <ATen/core/GeneratorForPrivateuseone.h>
 #include <ATen/detail/PrivateUse1HooksInterface.h>
 
@@ -11,6 +11,8 @@
 #include <c10/core/Device.h>
 #include <c10/core/impl/DeviceGuardImplInterface.h>
 
+#include <cstring>
+
 namespace remote {
 namespace {
 
@@ -27,13 +29,92 @@ static c10::DeviceIndex current_device_idx() {
   return get_method("get_device")().cast<c10::DeviceIndex>();
 }
 
-class RemoteGeneratorImpl : public at::CPUGeneratorImpl {
+// Counter-based (Philox) generator for remote devices. The client owns the
+// seed and offset; every random op reserves a range of the Philox counter and
+// ships (seed, offset) with its RPC, so the server RNG is fully determined by
+// client-side state and no round trip is needed to read or restore it.
+class RemoteGeneratorImpl : public c10::GeneratorImpl {
 public:
-  RemoteGeneratorImpl(c10::DeviceIndex device_index) {
-    device_ = c10::Device(c10::DeviceType::PrivateUse1, device_index);
-    key_set_ = c10::DispatchKeySet(c10::DispatchKey::PrivateUse1);
-  }
+  RemoteGeneratorImpl(c10::DeviceIndex device_index)
+      : c10::GeneratorImpl{
+            c10::Device(c10::DeviceType::PrivateUse1, device_index),
+            c10::DispatchKeySet(c10::DispatchKey::PrivateUse1)} {}
   ~RemoteGeneratorImpl() override = default;
+
+  void set_current_seed(uint64_t seed) override {
+    seed_ = seed;
+    philox_offset_ = 0;
+  }
+
+  uint64_t current_seed() const override { return seed_; }
+
+  uint64_t seed() override {
+    auto random = c10::detail::getNonDeterministicRandom();
+    set_current_seed(random);
+    return random;
+  }
+
+  void set_offset(uint64_t offset) override {
+    // Philox consumes counters in groups of 4 32-bit values
+    TORCH_CHECK(offset % 4 == 0, "offset must be a multiple of 4");
+    philox_offset_ = offset;
+  }
+
+  uint64_t get_offset() const override { return philox_offset_; }
+
+  // State layout matches CUDAGeneratorImpl: [seed (8 bytes), offset (8 bytes)]
+  c10::intrusive_ptr<c10::TensorImpl> get_state() const override {
+    static const size_t seed_size = sizeof(uint64_t);
+    static const size_t offset_size = sizeof(uint64_t);
+    static const size_t total_size = seed_size + offset_size;
+
+    auto state_tensor = at::empty({static_cast<int64_t>(total_size)},
+                                  at::TensorOptions().dtype(at::kByte));
+    auto rng_state = state_tensor.data_ptr<uint8_t>();
+    std::memcpy(rng_state, &seed_, seed_size);
+    std::memcpy(rng_state + seed_size, &philox_offset_, offset_size);
+    return state_tensor.getIntrusivePtr();
+  }
+
+  void set_state(const c10::TensorImpl &new_state) override {
+    static const size_t seed_size = sizeof(uint64_t);
+    static const size_t offset_size = sizeof(uint64_t);
+    static const size_t total_size = seed_size + offset_size;
+
+    at::detail::check_rng_state(new_state);
+    TORCH_CHECK(new_state.numel() == static_cast<int64_t>(total_size),
+                "RNG state is wrong size");
+
+    auto new_rng_state = new_state.data_dtype_initialized<uint8_t>();
+    uint64_t seed;
+    uint64_t offset;
+    std::memcpy(&seed, new_rng_state, seed_size);
+    std::memcpy(&offset, new_rng_state + seed_size, offset_size);
+    seed_ = seed;
+    philox_offset_ = offset;
+  }
+
+  // Reserve `increment` Philox counters and return the (seed, offset) pair the
+  // server should use for them. Rounded up so consecutive ops never overlap.
+  std::pair<uint64_t, uint64_t> philox_engine_inputs(uint64_t increment) {
+    increment = ((increment + 3) / 4) * 4;
+    uint64_t offset = philox_offset_;
+    philox_offset_ += increment;
+    return std::make_pair(seed_, offset);
+  }
+
+  static c10::DeviceType device_type() { return c10::DeviceType::PrivateUse1; }
+
+private:
+  RemoteGeneratorImpl *clone_impl() const override {
+    auto gen = new RemoteGeneratorImpl(device_.index());
+    gen->seed_ = seed_;
+    gen->philox_offset_ = philox_offset_;
+    return gen;
+  }
+
+  uint64_t seed_ = c10::default_rng_seed_val;
+  uint64_t philox_offset_ = 0;
 };
 
 static at::Generator make_remote_generator(c10::DeviceIndex device_index) {
@@ -53,10 +134,12 @@ struct RemoteHooksInterface : public at::PrivateUse1HooksInterface {
   }
 
   at::Allocator *getPinnedMemoryAllocator() const override {
-    TORCH_CHECK(false, "Pinned memory is not supported for remote tensors");
+    return get_host_staging_allocator();
   }
 
-  bool isPinnedPtr(const void *data) const override { return false; }
+  bool isPinnedPtr(const void *data) const override {
+    return is_host_staging_ptr(data);
+  }
 
   const at::Generator &
   getDefaultGenerator(c10::DeviceIndex device_index) const override {
@@ -198,7 +281,13 @@ struct RemoteGuardImpl final : public c10::impl::DeviceGuardImplInterface {
               const c10::DeviceIndex device_index,
               const c10::EventFlag flag) const override {
     py::gil_scoped_acquire acquire;
-    get_method("record")((int64_t)event, stream, device_index, (int64_t)flag);
+    // Events are created lazily on first record, like CUDA events
+    if (*event == nullptr) {
+      auto event_id =
+          get_method("create_event")(device_index, (int64_t)flag).cast<int64_t>();
+      *event = reinterpret_cast<void *>(event_id);
+    }
+    get_method("record")((int64_t)*event, stream, device_index, (int64_t)flag);
   }
 
   void block(void *event, const c10::Stream &stream) const override {
@@ -253,6 +342,13 @@ C10_REGISTER_GUARD_IMPL(PrivateUse1, RemoteGuardImpl);
 
 } // namespace
 
+std::pair<uint64_t, uint64_t> philox_engine_inputs(const at::Generator &gen,
+                                                   uint64_t increment) {
+  auto *impl = at::check_generator<RemoteGeneratorImpl>(gen);
+  std::lock_guard<std::mutex> lock(impl->mutex_);
+  return impl->philox_engine_inputs(increment);
+}
+
 // Setter for the python factory function
 void set_impl_factory(PyObject *factory) { py_factory = factory; }
 
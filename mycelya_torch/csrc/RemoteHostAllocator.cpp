@@ -0,0 +1,257 @@
+// Copyright (C) 2025 alyxya
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+#include "Remote.h"
+
+#include <c10/core/Allocator.h>
+#include <c10/util/Exception.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace remote {
+namespace {
+
+static bool env_flag(const char *name) {
+  const char *value = std::getenv(name);
+  return value != nullptr && std::strcmp(value, "0") != 0 &&
+         std::strcmp(value, "") != 0;
+}
+
+static size_t env_bytes(const char *name, size_t fallback) {
+  const char *value = std::getenv(name);
+  if (value == nullptr || *value == '\0') {
+    return fallback;
+  }
+  char *end = nullptr;
+  unsigned long long parsed = std::strtoull(value, &end, 10);
+  return *end == '\0' ? static_cast<size_t>(parsed) : fallback;
+}
+
+static size_t page_size() {
+#ifdef _WIN32
+  return 4096;
+#else
+  static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return size;
+#endif
+}
+
+// Host allocator backing pin_memory() for remote tensors. Buffers are
+// page-aligned, rounded up to size classes and recycled through per-class
+// free lists, so DataLoader pinning and upload staging reuse the same memory
+// instead of hitting the system allocator for every batch. Small buffers use
+// power-of-two classes; anything above kLargeGranularity is rounded to a
+// multiple of it so large batches waste at most 2MB each.
+//
+// At most MYCELYA_PINNED_CACHE_BYTES (default 1GB) of freed blocks are kept
+// for reuse; blocks released past that limit go straight back to the OS.
+// MYCELYA_PINNED_MLOCK=1 locks buffers into RAM and MYCELYA_PINNED_SHARED=1
+// backs them with shared mappings so they can be handed to other processes.
+struct HostStagingAllocator final : at::Allocator {
+  static constexpr size_t kLargeGranularity = size_t(2) << 20;
+  static constexpr size_t kDefaultCacheLimit = size_t(1) << 30;
+
+  HostStagingAllocator()
+      : use_mlock_(env_flag("MYCELYA_PINNED_MLOCK")),
+        use_shared_(env_flag("MYCELYA_PINNED_SHARED")),
+        cache_limit_(
+            env_bytes("MYCELYA_PINNED_CACHE_BYTES", kDefaultCacheLimit)) {}
+
+  at::DataPtr allocate(size_t nbytes) override {
+    if (nbytes == 0) {
+      return {nullptr, nullptr, &ReturnToPool, at::Device(at::kCPU)};
+    }
+
+    size_t size = size_class(nbytes);
+    void *ptr = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &free_list = free_blocks_[size];
+      if (!free_list.empty()) {
+        ptr = free_list.back();
+        free_list.pop_back();
+        cached_bytes_ -= size;
+        cache_hits_++;
+      }
+    }
+
+    if (ptr == nullptr) {
+      ptr = map_block(size);
+      std::lock_guard<std::mutex> lock(mutex_);
+      cache_misses_++;
+      reserved_bytes_ += size;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      live_blocks_[reinterpret_cast<uintptr_t>(ptr)] = size;
+      allocated_bytes_ += size;
+    }
+
+    return {ptr, ptr, &ReturnToPool, at::Device(at::kCPU)};
+  }
+
+  static void ReturnToPool(void *ptr);
+
+  at::DeleterFnPtr raw_deleter() const override { return &ReturnToPool; }
+
+  void copy_data(void *dest, const void *src, std::size_t count) const final {
+    std::memcpy(dest, src, count);
+  }
+
+  void release(void *ptr) {
+    size_t size = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = live_blocks_.find(reinterpret_cast<uintptr_t>(ptr));
+      TORCH_INTERNAL_ASSERT(it != live_blocks_.end(),
+                            "Pointer not allocated by the staging allocator");
+      size = it->second;
+      live_blocks_.erase(it);
+      allocated_bytes_ -= size;
+      if (cached_bytes_ + size <= cache_limit_) {
+        cached_bytes_ += size;
+        free_blocks_[size].push_back(ptr);
+        return;
+      }
+      reserved_bytes_ -= size;
+    }
+    // Over the cache limit: give the block back rather than pinning it forever
+    unmap_block(ptr, size);
+  }
+
+  // True if ptr points into a live block handed out by this allocator
+  bool contains(const void *ptr) {
+    auto addr = reinterpret_cast<uintptr_t>(ptr);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = live_blocks_.upper_bound(addr);
+    if (it == live_blocks_.begin()) {
+      return false;
+    }
+    --it;
+    return addr < it->first + it->second;
+  }
+
+  void empty_cache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &entry : free_blocks_) {
+      for (void *ptr : entry.second) {
+        unmap_block(ptr, entry.first);
+        reserved_bytes_ -= entry.first;
+      }
+      entry.second.clear();
+    }
+    cached_bytes_ = 0;
+  }
+
+  py::dict stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    py::dict result;
+    result["allocated_bytes"] = allocated_bytes_;
+    result["cached_bytes"] = cached_bytes_;
+    result["cache_limit_bytes"] = cache_limit_;
+    result["reserved_bytes"] = reserved_bytes_;
+    result["cache_hits"] = cache_hits_;
+    result["cache_misses"] = cache_misses_;
+    result["mlock"] = use_mlock_;
+    result["shared"] = use_shared_;
+    return result;
+  }
+
+private:
+  size_t size_class(size_t nbytes) const {
+    if (nbytes > kLargeGranularity) {
+      return (nbytes + kLargeGranularity - 1) / kLargeGranularity *
+             kLargeGranularity;
+    }
+    size_t size = page_size();
+    while (size < nbytes) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  void *map_block(size_t size) {
+#ifdef _WIN32
+    void *ptr = _aligned_malloc(size, page_size());
+    TORCH_CHECK(ptr != nullptr, "Failed to allocate ", size,
+                " bytes of pinned host memory");
+#else
+    int flags = MAP_ANONYMOUS | (use_shared_ ? MAP_SHARED : MAP_PRIVATE);
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    TORCH_CHECK(ptr != MAP_FAILED, "Failed to map ", size,
+                " bytes of pinned host memory");
+    if (use_mlock_ && mlock(ptr, size) != 0) {
+      TORCH_WARN_ONCE("mlock failed for pinned host memory (check "
+                      "RLIMIT_MEMLOCK); continuing with unlocked pages");
+    }
+#endif
+    return ptr;
+  }
+
+  void unmap_block(void *ptr, size_t size) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    if (use_mlock_) {
+      munlock(ptr, size);
+    }
+    munmap(ptr, size);
+#endif
+  }
+
+  std::mutex mutex_;
+  const bool use_mlock_;
+  const bool use_shared_;
+  const size_t cache_limit_;
+
+  // size class -> cached blocks ready for reuse
+  std::unordered_map<size_t, std::vector<void *>> free_blocks_;
+  // block address -> size class, ordered for interior pointer lookups
+  std::map<uintptr_t, size_t> live_blocks_;
+
+  size_t allocated_bytes_ = 0;
+  size_t cached_bytes_ = 0;
+  size_t reserved_bytes_ = 0;
+  size_t cache_hits_ = 0;
+  size_t cache_misses_ = 0;
+};
+
+// Intentionally leaked so pinned tensors freed during interpreter shutdown
+// never return blocks to a destroyed pool
+static HostStagingAllocator &host_alloc() {
+  static auto *alloc = new HostStagingAllocator();
+  return *alloc;
+}
+
+void HostStagingAllocator::ReturnToPool(void *ptr) {
+  if (ptr != nullptr) {
+    host_alloc().release(ptr);
+  }
+}
+
+} // namespace
+
+at::Allocator *get_host_staging_allocator() { return &host_alloc(); }
+
+bool is_host_staging_ptr(const void *ptr) {
+  return ptr != nullptr && host_alloc().contains(ptr);
+}
+
+void host_staging_empty_cache() { host_alloc().empty_cache(); }
+
+py::dict host_staging_stats() { return host_alloc().stats(); }
+
+} // namespace remote
@@ -0,0 +1,128 @@
+// Copyright (C) 2025 alyxya
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+#include "Remote.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace remote {
+namespace {
+
+int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Multi-producer single-consumer queue of RPC call records. Producers push
+// onto a Treiber stack with one CAS, so threads queueing calls never
+// serialize on a lock; the batch thread takes the whole stack with a single
+// exchange and reverses it into submission order. The queue only stores
+// record pointers and never touches Python, so none of it needs the GIL.
+class RpcQueue {
+public:
+  void push(PyObject *record, int64_t nbytes, bool blocking) {
+    auto *node = new Node{record, nbytes, head_.load(std::memory_order_relaxed)};
+    while (!head_.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+    queued_.fetch_add(1, std::memory_order_relaxed);
+    pending_bytes_.fetch_add(nbytes, std::memory_order_relaxed);
+
+    // Published after the node so a concurrent drain can only leave a
+    // spurious (early) deadline behind, never miss one
+    int64_t unset = 0;
+    oldest_ns_.compare_exchange_strong(unset, now_ns(),
+                                       std::memory_order_relaxed);
+    if (blocking) {
+      blocking_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  std::vector<PyObject *> drain() {
+    oldest_ns_.store(0, std::memory_order_relaxed);
+    blocking_.store(false, std::memory_order_relaxed);
+    Node *node = head_.exchange(nullptr, std::memory_order_acquire);
+
+    std::vector<PyObject *> records;
+    int64_t nbytes = 0;
+    while (node != nullptr) {
+      records.push_back(node->record);
+      nbytes += node->nbytes;
+      Node *next = node->next;
+      delete node;
+      node = next;
+    }
+    std::reverse(records.begin(), records.end());
+
+    pending_bytes_.fetch_sub(nbytes, std::memory_order_relaxed);
+    drained_.fetch_add(static_cast<int64_t>(records.size()),
+                       std::memory_order_relaxed);
+    return records;
+  }
+
+  RpcQueueState state() const {
+    RpcQueueState s;
+    s.queued_calls = queued_.load(std::memory_order_relaxed);
+    s.drained_calls = drained_.load(std::memory_order_relaxed);
+    // Counters of a push racing a drain may briefly lag the stack itself
+    s.pending_calls = std::max<int64_t>(0, s.queued_calls - s.drained_calls);
+    s.pending_bytes =
+        std::max<int64_t>(0, pending_bytes_.load(std::memory_order_relaxed));
+    int64_t oldest = oldest_ns_.load(std::memory_order_relaxed);
+    s.oldest_age = oldest == 0 ? 0.0 : (now_ns() - oldest) * 1e-9;
+    s.blocking = blocking_.load(std::memory_order_relaxed);
+    return s;
+  }
+
+private:
+  struct Node {
+    PyObject *record;
+    int64_t nbytes;
+    Node *next;
+  };
+
+  std::atomic<Node *> head_{nullptr};
+  std::atomic<int64_t> queued_{0};
+  std::atomic<int64_t> drained_{0};
+  std::atomic<int64_t> pending_bytes_{0};
+  std::atomic<int64_t> oldest_ns_{0};
+  std::atomic<bool> blocking_{false};
+};
+
+RpcQueue *from_handle(int64_t handle) {
+  TORCH_CHECK(handle != 0, "Invalid RPC queue handle");
+  return reinterpret_cast<RpcQueue *>(static_cast<uintptr_t>(handle));
+}
+
+} // namespace
+
+int64_t rpc_queue_new() {
+  return static_cast<int64_t>(reinterpret_cast<uintptr_t>(new RpcQueue()));
+}
+
+std::vector<PyObject *> rpc_queue_free(int64_t handle) {
+  RpcQueue *queue = from_handle(handle);
+  auto records = queue->drain();
+  delete queue;
+  return records;
+}
+
+void rpc_queue_push(int64_t handle, PyObject *record, int64_t nbytes,
+                    bool blocking) {
+  from_handle(handle)->push(record, nbytes, blocking);
+}
+
+std::vector<PyObject *> rpc_queue_drain(int64_t handle) {
+  return from_handle(handle)->drain();
+}
+
+RpcQueueState rpc_queue_state(int64_t handle) {
+  return from_handle(handle)->state();
+}
+
+} // namespace remote
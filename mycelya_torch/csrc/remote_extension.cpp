@@ -6,6 +6,8 @@
 #include <ATen/Context.h>
 
 #include <torch/csrc/Exceptions.h>
+#include <torch/csrc/Generator.h>
+#include <torch/csrc/autograd/python_variable.h>
 #include <torch/csrc/utils.h>
 #include <torch/csrc/utils/object_ptr.h>
 #include <torch/csrc/utils/python_numbers.h>
@@ -32,9 +34,206 @@ static PyObject *_getDefaultGenerator(PyObject *self, PyObject *arg) {
   END_HANDLE_TH_ERRORS
 }
 
+static PyObject *_philoxEngineInputs(PyObject *self, PyObject *args) {
+  HANDLE_TH_ERRORS
+  PyObject *gen_obj = nullptr;
+  PyObject *increment_obj = nullptr;
+  if (!PyArg_ParseTuple(args, "OO", &gen_obj, &increment_obj)) {
+    return nullptr;
+  }
+  TORCH_CHECK(THPGenerator_Check(gen_obj),
+              "_philox_engine_inputs expects a Generator, but got ",
+              THPUtils_typename(gen_obj));
+  TORCH_CHECK(THPUtils_checkLong(increment_obj),
+              "_philox_engine_inputs expects an int increment, but got ",
+              THPUtils_typename(increment_obj));
+  auto increment = static_cast<uint64_t>(THPUtils_unpackLong(increment_obj));
+
+  auto inputs = remote::philox_engine_inputs(
+      reinterpret_cast<THPGenerator *>(gen_obj)->cdata, increment);
+  return Py_BuildValue("(KK)",
+                       static_cast<unsigned long long>(inputs.first),
+                       static_cast<unsigned long long>(inputs.second));
+
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_isPinnedPtr(PyObject *self, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  TORCH_CHECK(THPUtils_checkLong(arg),
+              "_is_pinned_ptr expects an int, but got ",
+              THPUtils_typename(arg));
+  auto ptr = reinterpret_cast<const void *>(
+      static_cast<uintptr_t>(THPUtils_unpackUInt64(arg)));
+  if (remote::is_host_staging_ptr(ptr)) {
+    Py_RETURN_TRUE;
+  }
+  Py_RETURN_FALSE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_pinnedMemoryStats(PyObject *self, PyObject *noargs) {
+  HANDLE_TH_ERRORS
+  return remote::host_staging_stats().release().ptr();
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_pinnedMemoryEmptyCache(PyObject *self, PyObject *noargs) {
+  HANDLE_TH_ERRORS
+  remote::host_staging_empty_cache();
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_hostCopyAsync(PyObject *self, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  TORCH_CHECK(THPVariable_Check(arg),
+              "_host_copy_async expects a Tensor, but got ",
+              THPUtils_typename(arg));
+  auto result = remote::host_copy_async(THPVariable_Unpack(arg));
+  return Py_BuildValue("(NL)", THPVariable_Wrap(result.first),
+                       static_cast<long long>(result.second));
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_hostCopyWait(PyObject *self, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  TORCH_CHECK(THPUtils_checkLong(arg), "_host_copy_wait expects an int, but got ",
+              THPUtils_typename(arg));
+  auto ticket = THPUtils_unpackLong(arg);
+  {
+    pybind11::gil_scoped_release no_gil;
+    remote::host_copy_wait(ticket);
+  }
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_hostCopyQuery(PyObject *self, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  TORCH_CHECK(THPUtils_checkLong(arg),
+              "_host_copy_query expects an int, but got ",
+              THPUtils_typename(arg));
+  if (remote::host_copy_query(THPUtils_unpackLong(arg))) {
+    Py_RETURN_TRUE;
+  }
+  Py_RETURN_FALSE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_hashChunks(PyObject *self, PyObject *args) {
+  HANDLE_TH_ERRORS
+  PyObject *tensor_obj = nullptr;
+  PyObject *chunk_obj = nullptr;
+  if (!PyArg_ParseTuple(args, "OO", &tensor_obj, &chunk_obj)) {
+    return nullptr;
+  }
+  TORCH_CHECK(THPVariable_Check(tensor_obj),
+              "_hash_chunks expects a Tensor, but got ",
+              THPUtils_typename(tensor_obj));
+  TORCH_CHECK(THPUtils_checkLong(chunk_obj),
+              "_hash_chunks expects an int chunk size, but got ",
+              THPUtils_typename(chunk_obj));
+  const auto &data = THPVariable_Unpack(tensor_obj);
+  auto chunk_bytes = THPUtils_unpackLong(chunk_obj);
+
+  at::Tensor hashes;
+  {
+    pybind11::gil_scoped_release no_gil;
+    hashes = remote::hash_chunks(data, chunk_bytes);
+  }
+  return THPVariable_Wrap(std::move(hashes));
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *recordsToList(std::vector<PyObject *> records) {
+  // The list steals the references handed back by the queue
+  PyObject *list = PyList_New(static_cast<Py_ssize_t>(records.size()));
+  if (list == nullptr) {
+    for (PyObject *record : records) {
+      Py_DECREF(record);
+    }
+    return nullptr;
+  }
+  for (size_t i = 0; i < records.size(); i++) {
+    PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i), records[i]);
+  }
+  return list;
+}
+
+static PyObject *_rpcQueueNew(PyObject *self, PyObject *noargs) {
+  HANDLE_TH_ERRORS
+  return THPUtils_packInt64(remote::rpc_queue_new());
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_rpcQueueFree(PyObject *self, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  TORCH_CHECK(THPUtils_checkLong(arg),
+              "_rpc_queue_free expects an int handle, but got ",
+              THPUtils_typename(arg));
+  for (PyObject *record : remote::rpc_queue_free(THPUtils_unpackLong(arg))) {
+    Py_DECREF(record);
+  }
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_rpcQueuePush(PyObject *self, PyObject *args) {
+  HANDLE_TH_ERRORS
+  long long handle = 0;
+  PyObject *record = nullptr;
+  long long nbytes = 0;
+  int blocking = 0;
+  if (!PyArg_ParseTuple(args, "LOLp", &handle, &record, &nbytes, &blocking)) {
+    return nullptr;
+  }
+  Py_INCREF(record);
+  remote::rpc_queue_push(handle, record, nbytes, blocking != 0);
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_rpcQueueDrain(PyObject *self, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  TORCH_CHECK(THPUtils_checkLong(arg),
+              "_rpc_queue_drain expects an int handle, but got ",
+              THPUtils_typename(arg));
+  return recordsToList(remote::rpc_queue_drain(THPUtils_unpackLong(arg)));
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *_rpcQueueState(PyObject *self, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  TORCH_CHECK(THPUtils_checkLong(arg),
+              "_rpc_queue_state expects an int handle, but got ",
+              THPUtils_typename(arg));
+  auto state = remote::rpc_queue_state(THPUtils_unpackLong(arg));
+  return Py_BuildValue("(LLdNLL)", static_cast<long long>(state.pending_calls),
+                       static_cast<long long>(state.pending_bytes),
+                       state.oldest_age, PyBool_FromLong(state.blocking),
+                       static_cast<long long>(state.queued_calls),
+                       static_cast<long long>(state.drained_calls));
+  END_HANDLE_TH_ERRORS
+}
+
 static PyMethodDef methods[] = {
     {"_init", _initExtension, METH_NOARGS, nullptr},
     {"_get_default_generator", _getDefaultGenerator, METH_O, nullptr},
+    {"_philox_engine_inputs", _philoxEngineInputs, METH_VARARGS, nullptr},
+    {"_is_pinned_ptr", _isPinnedPtr, METH_O, nullptr},
+    {"_pinned_memory_stats", _pinnedMemoryStats, METH_NOARGS, nullptr},
+    {"_pinned_memory_empty_cache", _pinnedMemoryEmptyCache, METH_NOARGS,
+     nullptr},
+    {"_host_copy_async", _hostCopyAsync, METH_O, nullptr},
+    {"_host_copy_wait", _hostCopyWait, METH_O, nullptr},
+    {"_host_copy_query", _hostCopyQuery, METH_O, nullptr},
+    {"_hash_chunks", _hashChunks, METH_VARARGS, nullptr},
+    {"_rpc_queue_new", _rpcQueueNew, METH_NOARGS, nullptr},
+    {"_rpc_queue_free", _rpcQueueFree, METH_O, nullptr},
+    {"_rpc_queue_push", _rpcQueuePush, METH_VARARGS, nullptr},
+    {"_rpc_queue_drain", _rpcQueueDrain, METH_O, nullptr},
+    {"_rpc_queue_state", _rpcQueueState, METH_O, nullptr},
     {nullptr, nullptr, 0, nullptr}};
 
 static struct PyModuleDef remote_C_module = {
@@ -186,6 +186,53 @@ class RemoteMachine:
                 )
         self._client = None
 
+    def set_flush_policy(
+        self,
+        max_calls: Optional[int] = None,
+        max_bytes: Optional[int] = None,
+        max_age: Optional[float] = None,
+    ) -> None:
+        """Override when RPCs queued for this machine are sent as a batch.
+
+        Args:
+            max_calls: Pending call count that triggers a flush
+            max_bytes: Pending payload bytes that trigger a flush
+            max_age: Seconds the oldest pending call may wait, or None to
+                adapt it to the observed round-trip time
+        """
+        if self._client is None:
+            raise RuntimeError(f"Machine {self.machine_id} has no client")
+        self._client.set_flush_policy(max_calls, max_bytes, max_age)
+
+    def set_queue_limits(
+        self, max_calls: Optional[int] = None, max_bytes: Optional[int] = None
+    ) -> None:
+        """Bound the RPCs queued for this machine before callers wait.
+
+        Once either limit is reached, calls queueing more work block until
+        the batch sender drains the queue; stall time is reported by
+        torch.mycelya.batch_stats().
+
+        Args:
+            max_calls: Pending call limit, or None for the default (65536)
+            max_bytes: Pending payload byte limit, or None for the default
+                (256 MiB)
+        """
+        if self._client is None:
+            raise RuntimeError(f"Machine {self.machine_id} has no client")
+        self._client.set_queue_limits(max_calls, max_bytes)
+
+    def set_batch_window(self, window: int) -> None:
+        """Set how many RPC batches may be in flight to this machine at once.
+
+        Args:
+            window: Batches in flight, between 1 and 16; 1 waits for each
+                batch to finish before sending the next
+        """
+        if self._client is None:
+            raise RuntimeError(f"Machine {self.machine_id} has no client")
+        self._client.set_batch_window(window)
+
     def __enter__(self) -> "RemoteMachine":
         """Enter the context manager and ensure client is started."""
         if self._client is None or not self._client.is_running():
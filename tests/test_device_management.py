@@ -8,6 +8,8 @@ This module tests device creation, validation, registry management,
 and device property verification.
 """
 
+from concurrent.futures import Future
+
 import pytest
 import torch
 from test_utilities import DeviceTestUtils, TestConstants
@@ -152,6 +154,467 @@ def test_device_cleanup_behavior(shared_devices):
     del tensors
 
 
+def test_rng_state_roundtrip_reproduces_random_ops(shared_devices):
+    """Test that restoring the client-side RNG state reproduces random ops."""
+    device = shared_devices["t4"].device()
+    torch.mycelya.manual_seed(1234, device)
+
+    state = torch.mycelya.get_rng_state(device)
+    assert state.dtype == torch.uint8
+    assert state.numel() == 16
+
+    first = torch.randn(4, 4, device=device).cpu()
+    torch.mycelya.set_rng_state(state, device)
+    second = torch.randn(4, 4, device=device).cpu()
+    assert torch.equal(first, second)
+
+    # Consecutive ops draw from disjoint counter ranges
+    third = torch.randn(4, 4, device=device).cpu()
+    assert not torch.equal(second, third)
+
+
+def test_flush_policy_triggers(shared_devices):
+    """Test the RPC flush triggers and per-machine overrides."""
+    from mycelya_torch._flush_policy import FlushPolicy
+
+    policy = FlushPolicy()
+    assert policy.check(0, 0, 10.0, True) is None
+    assert policy.check(1, 0, 0.0, True) == "blocking"
+
+    policy.configure(max_calls=4, max_bytes=100)
+    assert policy.check(4, 0, 0.0, False) == "calls"
+    assert policy.check(1, 100, 0.0, False) == "bytes"
+
+    # The age deadline follows the observed round-trip time
+    policy.observe_rtt(0.02)
+    assert policy.max_age == pytest.approx(0.005)
+    assert policy.check(1, 0, 0.001, False) is None
+    assert policy.check(1, 0, 0.01, False) == "age"
+    assert policy.time_until_due(1, 0.001) == pytest.approx(0.004)
+
+    machine = shared_devices["t4"]
+    machine.set_flush_policy(max_calls=8)
+    try:
+        assert machine._client._flush_policy.get_stats()["max_calls"] == 8
+        result = (torch.ones(2, 2, device=machine.device()) * 3).cpu()
+        assert torch.equal(result, torch.full((2, 2), 3.0))
+    finally:
+        machine.set_flush_policy()
+
+
+def test_rpc_batch_queue_concurrent_producers():
+    """Test that calls queued from many threads drain in per-thread order."""
+    import threading
+
+    from mycelya_torch._batching import RPCBatchQueue
+
+    queue = RPCBatchQueue("test")
+    num_threads, calls_per_thread = 4, 500
+
+    def produce(thread_index):
+        for i in range(calls_per_thread):
+            queue.enqueue_call("spawn", "noop", (thread_index, i, b"x" * 8), {})
+
+    threads = [threading.Thread(target=produce, args=(t,)) for t in range(num_threads)]
+    for thread in threads:
+        thread.start()
+    batch = []
+    while any(thread.is_alive() for thread in threads):
+        batch.extend(queue.get_batch())
+    for thread in threads:
+        thread.join()
+    batch.extend(queue.get_batch())
+
+    assert len(batch) == num_threads * calls_per_thread
+    for thread_index in range(num_threads):
+        sequence = [call.args[1] for call in batch if call.args[0] == thread_index]
+        assert sequence == list(range(calls_per_thread))
+
+    future = queue.enqueue_call("remote", "noop", (b"y" * 16,), {})
+    calls, nbytes, age, blocking = queue.pending()
+    assert (calls, nbytes, blocking) == (1, 16, True) and age >= 0.0
+    queue.clear()
+    assert future.cancelled()
+    assert queue.pending()[0] == 0
+
+
+def test_rpc_batch_queue_dependent_batch():
+    """Test that a blocking read takes only its producers and earlier calls."""
+    from mycelya_torch._batching import RPCBatchQueue
+
+    queue = RPCBatchQueue("test")
+    queue.enqueue_call("spawn", "create_storage", (1, 8), {}, writes=(1,))
+    queue.enqueue_call("spawn", "create_storage", (2, 8), {}, writes=(2,))
+    queue.enqueue_call("spawn", "op", (), {}, writes=(1,), reads=(2,))
+    queue.enqueue_call("spawn", "op", (), {}, writes=(2,), reads=(2,))
+    read = queue.enqueue_call("remote", "get_storage_data", (1,), {}, reads=(1,))
+    queue.enqueue_call("spawn", "op", (b"z" * 4,), {}, writes=(1,), reads=(1,))
+
+    # The read goes out after the last write to storage 1; the unrelated
+    # write to storage 2 and the later write to storage 1 stay queued
+    batch = queue.get_dependent_batch()
+    assert [call.args for call in batch] == [(1, 8), (2, 8), (), (1,)]
+    assert batch[-1].future is read
+    calls, nbytes, _, blocking = queue.pending()
+    assert (calls, nbytes, blocking) == (2, 4, False)
+    assert queue.get_stats()["dependent_flushes"] == 1
+
+    # Held calls go out ahead of anything queued later
+    queue.enqueue_call("spawn", "op", (), {}, writes=(3,))
+    assert [call.writes for call in queue.get_batch()] == [(2,), (1,), (3,)]
+
+    # Blocking calls that write, or whose reads are unknown, take everything
+    queue.enqueue_call("spawn", "op", (), {}, writes=(2,))
+    queue.enqueue_call("remote", "op", (), {}, writes=(1,), reads=(1,))
+    queue.enqueue_call("remote", "op", (), {})
+    assert len(queue.get_dependent_batch()) == 3
+    assert queue.pending()[0] == 0
+
+
+def test_rpc_batch_queue_priority_lane():
+    """Test that priority calls jump ahead of bulk calls they do not depend on."""
+    from mycelya_torch._batching import RPCBatchQueue
+
+    queue = RPCBatchQueue("test")
+    queue.enqueue_call("spawn", "upload", (b"x" * 64,), {}, writes=(1,), reads=())
+    queue.enqueue_call("spawn", "create_storage", (2, 8), {}, writes=(2,), reads=())
+    queue.enqueue_call("spawn", "op", (), {}, writes=(3,), reads=(1,))
+    queue.enqueue_call("spawn", "op", (), {}, writes=(2,), reads=(2,), priority=True)
+    assert queue.pending()[3]
+
+    # The priority op only needs the storage it writes; the upload and the
+    # op reading it stay queued behind it
+    batch = queue.get_dependent_batch()
+    assert [call.method_name for call in batch] == ["create_storage", "op"]
+    assert queue.pending()[:2] == (2, 64)
+    stats = queue.get_stats()
+    assert (stats["priority_flushes"], stats["dependent_flushes"]) == (1, 1)
+
+    # Priority calls reading a bulk write take it and its own dependencies
+    queue.enqueue_call("spawn", "op", (), {}, reads=(3,), priority=True)
+    batch = queue.get_dependent_batch()
+    assert [call.method_name for call in batch] == ["upload", "op", "op"]
+    assert all(call.priority for call in batch[2:])
+
+    # Unknown reads keep everything before them
+    queue.enqueue_call("spawn", "op", (), {}, writes=(4,), reads=())
+    queue.enqueue_call("spawn", "op", (), {}, priority=True)
+    assert len(queue.get_dependent_batch()) == 2
+
+
+def test_batch_pipeline_priority_lane():
+    """Test that lanes are ordered separately unless they share storages."""
+    import threading
+    import time
+
+    from mycelya_torch._batching import BatchedRPC, BatchPipeline
+
+    class FakeServer:
+        def __init__(self):
+            self.lock = threading.Lock()
+            self.finished = []
+            self.orders = []
+            self.execute_batch = self
+
+        def remote(self, batch_calls, order=None):
+            with self.lock:
+                self.orders.append(order)
+            time.sleep(0.2 if batch_calls[0]["method_name"] == "bulk" else 0.01)
+            with self.lock:
+                self.finished.append(batch_calls[0]["args"][0])
+            return [None for _ in batch_calls]
+
+    def call(name, storage_id, reads):
+        return BatchedRPC("remote", name, (name,), {}, Future(), (storage_id,), reads)
+
+    server = FakeServer()
+    pipeline = BatchPipeline("test", window=1)
+    pipeline.submit(server, [call("bulk", 1, ())], lambda result: None)
+    # Independent priority work overtakes the bulk batch in flight, even with
+    # the window full; dependent work waits for it
+    pipeline.submit(server, [call("fast", 2, ())], lambda result: None, priority=True)
+    pipeline.submit(
+        server, [call("after", 3, (1,))], lambda result: None, priority=True
+    )
+    pipeline.wait_idle()
+
+    assert server.finished == ["fast", "bulk", "after"]
+    sessions = [session for session, _ in server.orders]
+    assert sessions[0] != sessions[1] and len(set(sessions)) == 2
+    stats = pipeline.get_stats()
+    assert (stats["sent_batches"], stats["priority_batches"]) == (3, 2)
+
+
+def test_rpc_batch_queue_backpressure():
+    """Test that producers wait for the sender once the queue is full."""
+    import threading
+    import time
+
+    from mycelya_torch._batching import RPCBatchQueue, no_backpressure
+
+    queue = RPCBatchQueue("test")
+    queue.set_limits(max_calls=4, max_bytes=64)
+
+    # A call larger than the byte limit still fits into an empty queue
+    queue.wait_for_capacity(1024)
+    for _ in range(4):
+        queue.enqueue_call("spawn", "noop", (b"x" * 8,), {})
+
+    woken = threading.Event()
+    producer = threading.Thread(target=queue.wait_for_capacity, args=(8, woken.set))
+    producer.start()
+    time.sleep(0.05)
+    assert producer.is_alive() and woken.is_set()
+    with no_backpressure():
+        queue.wait_for_capacity(8)
+
+    assert len(queue.get_batch()) == 4
+    producer.join(timeout=5.0)
+    assert not producer.is_alive()
+
+    backpressure = queue.get_stats()["backpressure"]
+    assert backpressure["stalls"] == 1
+    assert backpressure["stall_time"] >= 0.05
+    assert backpressure["max_pending_calls"] == 4
+    assert backpressure["max_pending_bytes"] == 64
+
+    with pytest.raises(ValueError):
+        queue.set_limits(max_calls=0)
+
+
+def test_batch_optimizer_eliminates_dead_calls():
+    """Test that the batch optimizer cancels, collapses and drops dead calls."""
+    from mycelya_torch._batch_optimizer import optimize_batch
+    from mycelya_torch._batching import BatchedRPC
+
+    def call(method_name, *args, writes=(), reads=()):
+        return BatchedRPC("spawn", method_name, args, {}, None, writes, reads)
+
+    def update(storage_id, numel):
+        layout = ([numel], [1], 0, "torch.float32")
+        payload = b"x" * 4 * numel
+        args = (storage_id, payload, *layout, *layout)
+        return call("update_storage", *args, writes=(storage_id,))
+
+    batch = [
+        # Temporary storage created, written and removed unread
+        call("create_storage", 1, 64, writes=(1,)),
+        update(1, 16),
+        call("remove_storage", 1, writes=(1,)),
+        # Resize chain on storage 2
+        call("resize_storage", 2, 32, writes=(2,), reads=(2,)),
+        call("resize_storage", 2, 128, writes=(2,), reads=(2,)),
+        call("resize_storage", 2, 64, writes=(2,), reads=(2,)),
+        # Storage 3 written twice before it is read; the second write
+        # covers the first and half of a packed entry
+        call(
+            "write_storages_packed",
+            [(3, 0, 0, 8), (4, 0, 8, 8)],
+            b"y" * 16,
+            writes=(3, 4),
+        ),
+        update(3, 1),
+        call("write_storage_bytes", 3, 0, b"z" * 4, writes=(3,)),
+        BatchedRPC("remote", "read_storage_bytes", (3, 0, 8), {}, None, (), (3,)),
+    ]
+    optimized, eliminated = optimize_batch(batch)
+
+    assert len(eliminated) == 6
+    assert [c.method_name for c in optimized] == [
+        "resize_storage",
+        "write_storages_packed",
+        "write_storage_bytes",
+        "read_storage_bytes",
+    ]
+    assert optimized[0].args == (2, 128)
+    assert optimized[1].args[0] == [(3, 4, 4, 4), (4, 0, 8, 8)]
+
+    # A call with unknown reads keeps everything before it
+    barrier = BatchedRPC("spawn", "execute_aten_operation", (), {}, None, (5,))
+    optimized, eliminated = optimize_batch([update(3, 1), barrier, update(3, 1)])
+    assert len(optimized) == 3 and not eliminated
+
+
+def test_op_templates_roundtrip():
+    """Test that repeated aten calls are sent as template references."""
+    from _mycelya_torch_modal.modal_app import _fill_template
+    from mycelya_torch._op_templates import OpTemplateEncoder
+
+    def aten_call(input_id, output_id, alpha):
+        metadata = {
+            "storage_id": input_id,
+            "shape": [4, 8],
+            "stride": [8, 1],
+            "storage_offset": 0,
+            "dtype": "float32",
+        }
+        args = ("aten::add.Tensor", [metadata], [output_id], ["__TENSOR_0", 1.0])
+        return {
+            "method_name": "execute_aten_operation",
+            "call_type": "spawn",
+            "args": args + ({"alpha": alpha},),
+            "kwargs": {},
+        }
+
+    encoder = OpTemplateEncoder()
+    calls = [aten_call(10 + step, 20 + step, step) for step in range(3)]
+    encoded = encoder.encode(calls)
+
+    # Only the first call carries the skeleton; all share one template
+    assert "template_def" in encoded[0]
+    assert all("template_def" not in call for call in encoded[1:])
+    assert {call["template"] for call in encoded} == {encoded[0]["template"]}
+    assert encoded[2]["args"] == [12, 22, 1.0, 2]
+
+    skeleton = encoded[0]["template_def"]
+    for call, original in zip(encoded, calls):
+        assert _fill_template(skeleton, iter(call["args"])) == original["args"]
+
+    # A different shape needs its own template
+    other = aten_call(1, 2, 0)
+    other["args"][1][0]["shape"] = [8, 4]
+    assert "template_def" in encoder.encode([other])[0]
+    assert encoder.get_stats()["templates"] == 2
+
+
+def test_batch_pipeline_keeps_window_in_flight():
+    """Test that pipelined batches overlap up to the window and all resolve."""
+    import threading
+    import time
+
+    from mycelya_torch._batching import BatchPipeline, BatchedRPC
+
+    class FakeServer:
+        def __init__(self):
+            self.lock = threading.Lock()
+            self.active = 0
+            self.max_active = 0
+            self.orders = []
+            self.execute_batch = self
+
+        def remote(self, batch_calls, order=None):
+            with self.lock:
+                self.active += 1
+                self.max_active = max(self.max_active, self.active)
+                self.orders.append(order)
+            time.sleep(0.05)
+            with self.lock:
+                self.active -= 1
+            return [call["args"][0] for call in batch_calls]
+
+    server = FakeServer()
+    pipeline = BatchPipeline("test", window=2)
+    results = []
+    futures = []
+    for i in range(6):
+        future = Future()
+        futures.append(future)
+        batch = [BatchedRPC("remote", "noop", (i,), {}, future)]
+        pipeline.submit(server, batch, results.append)
+    pipeline.wait_idle()
+
+    assert [future.result() for future in futures] == list(range(6))
+    assert len(results) == 6
+    assert server.max_active == 2
+    assert sorted(seq for _, seq in server.orders) == list(range(6))
+    assert len({session for session, _ in server.orders}) == 1
+
+
+def test_batch_pipeline_restarts_lost_session():
+    """Test that a lost batch starts a new session once its lane drains."""
+    import threading
+    import time
+
+    from mycelya_torch._batching import BatchPipeline, BatchedRPC
+
+    class FakeServer:
+        def __init__(self):
+            self.lock = threading.Lock()
+            self.events = []
+            self.execute_batch = self
+
+        def remote(self, batch_calls, order=None):
+            name = batch_calls[-1]["args"][0]
+            defines = any("template_def" in c for c in batch_calls)
+            with self.lock:
+                self.events.append(("start", name, order, defines))
+            if name == "lost":
+                raise ConnectionError("lost in transit")
+            if name == "slow":
+                time.sleep(0.2)
+            with self.lock:
+                self.events.append(("end", name, order, False))
+            if name == "bad":
+                return [RuntimeError("shape mismatch") for _ in batch_calls]
+            return [None for _ in batch_calls]
+
+    def aten_batch(name):
+        metadata = {
+            "storage_id": 10,
+            "shape": [4],
+            "stride": [1],
+            "storage_offset": 0,
+            "dtype": "float32",
+        }
+        args = ("aten::neg", [metadata], [11], ["__TENSOR_0"], {})
+        return [
+            BatchedRPC("spawn", "execute_aten_operation", args, {}, Future()),
+            BatchedRPC("remote", "noop", (name,), {}, Future()),
+        ]
+
+    def call(name):
+        return [BatchedRPC("remote", "noop", (name,), {}, Future())]
+
+    server = FakeServer()
+    pipeline = BatchPipeline("test", window=2)
+
+    # A batch the server ran with every call failing keeps the session
+    pipeline.submit(server, call("bad"), lambda result: None)
+    pipeline.wait_idle()
+    pipeline.submit(server, call("slow"), lambda result: None)
+    lost = aten_batch("lost")
+    lost_done = threading.Event()
+    pipeline.submit(server, lost, lambda result: lost_done.set())
+    assert lost_done.wait(timeout=1)
+    assert isinstance(lost[1].future.exception(), ConnectionError)
+
+    # The next batch waits for the slow batch of the old session, then
+    # redefines its template at the start of a new session
+    pipeline.submit(server, aten_batch("next"), lambda result: None)
+    pipeline.wait_idle()
+
+    starts = {
+        name: (order, defines)
+        for kind, name, order, defines in server.events
+        if kind == "start"
+    }
+    orders = {name: order for name, (order, _) in starts.items()}
+    assert orders["bad"][0] == orders["slow"][0] == orders["lost"][0]
+    assert orders["next"][0] != orders["lost"][0] and orders["next"][1] == 0
+    assert starts["next"][1]
+    events = [(kind, name) for kind, name, _, _ in server.events]
+    assert events.index(("end", "slow")) < events.index(("start", "next"))
+    assert pipeline.get_stats()["sent_batches"] == 4
+
+
+def test_batch_sender_per_machine(shared_devices):
+    """Test that every machine gets its own independent batch sender."""
+    import threading
+
+    from mycelya_torch._remote_orchestrator import remote_orchestrator
+
+    machines = [shared_devices["t4"], shared_devices["l4"]]
+    for machine in machines:
+        assert torch.ones(2, device=machine.device()).sum().item() == 2.0
+
+    stats = remote_orchestrator.get_batch_stats()
+    senders = {c["client_id"]: c["sender"] for c in stats["clients"]}
+    thread_names = {thread.name for thread in threading.enumerate()}
+    for machine in machines:
+        assert senders[machine.machine_id]["thread_alive"]
+        assert f"RPCBatchProcessor-{machine.machine_id}" in thread_names
+
+
 def test_device_error_handling_graceful():
     """Test that device-related errors are handled gracefully."""
     # These operations might fail, but shouldn't crash
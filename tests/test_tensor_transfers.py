@@ -8,6 +8,8 @@ This module tests CPU<->remote transfers, cross-device restrictions,
 device conversions, and transfer error handling.
 """
 
+import asyncio
+
 import pytest
 import torch
 from test_utilities import (
@@ -85,6 +87,145 @@ class TestCPUToRemoteTransfers:
         except (RuntimeError, NotImplementedError):
             pytest.skip(f"dtype {dtype} not supported on remote device")
 
+    def test_pinned_cpu_to_remote_transfer(self, shared_devices):
+        """Test uploading a tensor staged in the pinned host pool."""
+        cpu_tensor = torch.randn(8, 8)
+        pinned = cpu_tensor.pin_memory("mycelya")
+
+        assert pinned.is_pinned("mycelya")
+        assert not cpu_tensor.is_pinned("mycelya")
+
+        remote_tensor = pinned.to(shared_devices["t4"].device())
+        NumericalTestUtils.assert_tensors_close(remote_tensor.cpu(), cpu_tensor)
+
+    def test_compressible_transfer_roundtrip(self, shared_devices):
+        """Test that highly compressible data survives compressed transfers."""
+        machine = shared_devices["t4"]
+        mask = torch.zeros(512, 512, dtype=torch.int64)
+        mask[::7, ::3] = 1
+
+        before = torch.mycelya.transfer_stats()[machine.machine_id]
+        remote_tensor = mask.to(machine.device())
+        assert torch.equal(remote_tensor.cpu(), mask)
+
+        stats = torch.mycelya.transfer_stats()[machine.machine_id]
+        for direction in ("upload", "download"):
+            assert stats[direction]["transfers"] > before[direction]["transfers"]
+        # The in-process mock transport passes buffers by reference uncompressed
+        assert stats["codecs"]["none"] > before["codecs"].get("none", 0)
+
+    def test_forced_compression_mock_transport(self, shared_devices):
+        """Test that compressible transfers use a codec when mock compression is on."""
+        from mycelya_torch._compression import accepted_codecs
+
+        if not accepted_codecs():
+            pytest.skip("No compression codec installed")
+
+        machine = shared_devices["t4"]
+        mask = torch.zeros(512, 512, dtype=torch.int64)
+        mask[::5, ::2] = 1
+
+        machine._client.set_transport_compression(True)
+        try:
+            before = torch.mycelya.transfer_stats()[machine.machine_id]
+            remote_tensor = mask.to(machine.device())
+            assert torch.equal(remote_tensor.cpu(), mask)
+            stats = torch.mycelya.transfer_stats()[machine.machine_id]
+        finally:
+            machine._client.set_transport_compression(False)
+
+        compressed = sum(
+            count for codec, count in stats["codecs"].items() if codec != "none"
+        )
+        compressed_before = sum(
+            count for codec, count in before["codecs"].items() if codec != "none"
+        )
+        assert compressed > compressed_before
+        upload_raw = stats["upload"]["raw_bytes"] - before["upload"]["raw_bytes"]
+        upload_wire = stats["upload"]["wire_bytes"] - before["upload"]["wire_bytes"]
+        assert upload_wire < upload_raw / 4
+
+    def test_non_contiguous_cpu_to_remote_transfer(self, shared_devices):
+        """Test uploading strided and offset views into a remote view."""
+        base = torch.randn(6, 8)
+        source = base.t()[2:6, 1:5]  # transposed, offset view
+        assert not source.is_contiguous()
+
+        remote_tensor = torch.zeros(4, 6).to(shared_devices["t4"].device())
+        remote_tensor[:, 1:5].copy_(source)
+
+        expected = torch.zeros(4, 6)
+        expected[:, 1:5] = source
+        NumericalTestUtils.assert_tensors_close(remote_tensor.cpu(), expected)
+
+    def test_packed_module_upload(self, shared_devices):
+        """Test that Module.to and load_state_dict pack parameters into one upload."""
+        machine_id = shared_devices["t4"].machine_id
+        model = torch.nn.Sequential(
+            torch.nn.Linear(8, 16), torch.nn.ReLU(), torch.nn.Linear(16, 4)
+        )
+        expected = {name: t.clone() for name, t in model.state_dict().items()}
+
+        uploads = torch.mycelya.transfer_stats()[machine_id]["upload"]["transfers"]
+        model.to(shared_devices["t4"].device())
+        for name, t in model.state_dict().items():
+            NumericalTestUtils.assert_tensors_close(t.cpu(), expected[name])
+        # Fewer payloads than tensors (normally a single packed payload)
+        stats = torch.mycelya.transfer_stats()[machine_id]["upload"]
+        assert stats["transfers"] - uploads < len(expected)
+
+        new_state = {name: torch.randn_like(t) for name, t in expected.items()}
+        model.load_state_dict(new_state)
+        for name, t in model.state_dict().items():
+            NumericalTestUtils.assert_tensors_close(t.cpu(), new_state[name])
+
+    def test_load_safetensors(self, shared_devices, tmp_path, monkeypatch):
+        """Test streaming a safetensors checkpoint straight into remote storages."""
+        import json
+        import struct
+
+        import mycelya_torch
+        import mycelya_torch._tensor_utils as tensor_utils
+
+        monkeypatch.setattr(tensor_utils, "TRANSFER_CHUNK_BYTES", 4096)
+        monkeypatch.setattr(tensor_utils, "DELTA_CHUNK_BYTES", 4096)
+
+        expected = {
+            "weight": torch.randn(64, 48),  # streamed in several chunks
+            "bias": torch.randn(48).to(torch.bfloat16),  # packed
+            "ids": torch.arange(10),
+            "mask": torch.tensor([True, False, True]),
+            "empty": torch.empty(0, 4),
+        }
+        dtype_codes = {
+            torch.float32: "F32",
+            torch.bfloat16: "BF16",
+            torch.int64: "I64",
+            torch.bool: "BOOL",
+        }
+        header, blobs, offset = {}, [], 0
+        for name, t in expected.items():
+            data = t.reshape(-1).view(torch.uint8).numpy().tobytes()
+            header[name] = {
+                "dtype": dtype_codes[t.dtype],
+                "shape": list(t.shape),
+                "data_offsets": [offset, offset + len(data)],
+            }
+            blobs.append(data)
+            offset += len(data)
+        header_bytes = json.dumps(header).encode()
+        path = tmp_path / "model.safetensors"
+        path.write_bytes(
+            struct.pack("<Q", len(header_bytes)) + header_bytes + b"".join(blobs)
+        )
+
+        loaded = mycelya_torch.load_safetensors(str(path), shared_devices["t4"])
+        assert set(loaded) == set(expected)
+        for name, t in expected.items():
+            DeviceTestUtils.verify_device_properties(loaded[name], shared_devices["t4"])
+            assert loaded[name].dtype == t.dtype
+            assert torch.equal(loaded[name].cpu(), t)
+
 
 class TestRemoteToCPUTransfers:
     """Tests for transferring tensors from remote devices to CPU."""
@@ -115,6 +256,21 @@ class TestRemoteToCPUTransfers:
             assert back_to_cpu.shape == shape
             NumericalTestUtils.assert_tensors_close(back_to_cpu, original_cpu)
 
+    def test_remote_view_to_cpu_transfer(self, shared_devices):
+        """Test downloading small strided views of a larger remote tensor."""
+        original_cpu = torch.randn(16, 32)
+        remote_tensor = original_cpu.to(shared_devices["t4"].device())
+
+        NumericalTestUtils.assert_tensors_close(
+            remote_tensor[:, -1].cpu(), original_cpu[:, -1]
+        )
+        NumericalTestUtils.assert_tensors_close(
+            remote_tensor[3].cpu(), original_cpu[3]
+        )
+        NumericalTestUtils.assert_tensors_close(
+            remote_tensor.t()[5:7].cpu(), original_cpu.t()[5:7]
+        )
+
     def test_remote_to_cpu_preserves_gradients(self, shared_devices):
         """Test that remote to CPU transfer preserves gradient information."""
         original_cpu = torch.randn(2, 2, requires_grad=True)
@@ -155,6 +311,19 @@ class TestRemoteToCPUTransfers:
             result_back_to_cpu, result_cpu_reference
         )
 
+    def test_downloaded_tensor_does_not_alias_remote(self, shared_devices):
+        """Test that downloads stay intact when the remote tensor changes."""
+        expected = torch.arange(16, dtype=torch.float32)
+        remote_tensor = expected.to(shared_devices["t4"].device())
+
+        host = remote_tensor.cpu()
+        chunk = remote_tensor[4:12].cpu()
+        remote_tensor.add_(1)
+
+        assert torch.equal(host, expected)
+        assert torch.equal(chunk, expected[4:12])
+        assert torch.equal(remote_tensor.cpu(), expected + 1)
+
 
 class TestCrossDeviceTransferRestrictions:
     """Tests for cross-device transfer restrictions and error handling."""
@@ -263,6 +432,64 @@ class TestTransferWithConversions:
         except (RuntimeError, NotImplementedError):
             pytest.skip("non_blocking parameter not supported")
 
+    def test_non_blocking_roundtrip_after_synchronize(self, shared_devices):
+        """Test non_blocking uploads and pinned downloads complete on synchronize."""
+        cpu_tensor = torch.randn(4, 8)
+
+        remote_tensor = cpu_tensor.to(shared_devices["t4"].device(), non_blocking=True)
+        result = remote_tensor * 2
+
+        host_out = torch.empty(4, 8).pin_memory("mycelya")
+        host_out.copy_(result, non_blocking=True)
+        torch.mycelya.synchronize()
+
+        assert torch.allclose(host_out, cpu_tensor * 2, rtol=1e-4, atol=1e-6)
+
+    def test_async_results(self, shared_devices):
+        """Test cpu_async, item_async and their awaitable variants."""
+        cpu_tensor = torch.randn(4, 8)
+        remote_tensor = cpu_tensor.to(shared_devices["t4"].device())
+
+        tensor_future = torch.mycelya.cpu_async(remote_tensor * 2)
+        item_future = torch.mycelya.item_async(remote_tensor.sum())
+        assert torch.allclose(tensor_future.result(), cpu_tensor * 2)
+        assert item_future.result() == pytest.approx(cpu_tensor.sum().item(), rel=1e-4)
+
+        async def fetch():
+            return await asyncio.gather(
+                torch.mycelya.acpu(remote_tensor[1:, ::2]),
+                torch.mycelya.aitem(remote_tensor.max()),
+            )
+
+        view, largest = asyncio.run(fetch())
+        assert torch.allclose(view, cpu_tensor[1:, ::2])
+        assert largest == pytest.approx(cpu_tensor.max().item())
+
+        with pytest.raises(RuntimeError):
+            torch.mycelya.item_async(remote_tensor)
+
+    def test_reduced_precision_wire_dtype(self, shared_devices):
+        """Test bf16 on the wire restores fp32 at both ends within bf16 precision."""
+        cpu_tensor = torch.randn(32, 32)
+        expected = cpu_tensor.to(torch.bfloat16).float()
+
+        with torch.mycelya.wire_dtype(torch.bfloat16):
+            remote_tensor = cpu_tensor.to(shared_devices["t4"].device())
+        assert remote_tensor.dtype == torch.float32
+        assert torch.equal(remote_tensor.cpu(), expected)
+
+        # Per-tensor policy applies to downloads of that tensor's storage
+        full = cpu_tensor.to(shared_devices["t4"].device())
+        torch.mycelya.set_wire_dtype(full, torch.bfloat16)
+        downloaded = full.cpu()
+        assert downloaded.dtype == torch.float32
+        assert torch.equal(downloaded, expected)
+
+        # Integer data is never narrowed
+        ints = torch.arange(100)
+        with torch.mycelya.wire_dtype(torch.float16):
+            assert torch.equal(ints.to(shared_devices["t4"].device()).cpu(), ints)
+
     def test_transfer_dtype_and_device_combined(self, shared_devices):
         """Test transfer with both device and dtype conversion."""
         cpu_tensor = torch.randn(2, 2, dtype=torch.float32)
@@ -303,6 +530,91 @@ class TestTransferErrorHandling:
         except (RuntimeError, MemoryError):
             pytest.skip("Large tensor transfer not supported or insufficient memory")
 
+    def test_chunked_streaming_transfers(self, shared_devices, monkeypatch):
+        """Test uploads and downloads split into many pipelined chunks."""
+        import mycelya_torch._aten_impl as aten_impl
+        import mycelya_torch._tensor_utils as tensor_utils
+
+        monkeypatch.setattr(tensor_utils, "TRANSFER_CHUNK_BYTES", 4096)
+        monkeypatch.setattr(tensor_utils, "DELTA_CHUNK_BYTES", 4096)
+        monkeypatch.setattr(aten_impl, "TRANSFER_CHUNK_BYTES", 4096)
+
+        cpu_tensor = torch.randn(64, 96)
+        remote_tensor = cpu_tensor.to(shared_devices["t4"].device())
+        NumericalTestUtils.assert_tensors_close(remote_tensor.cpu(), cpu_tensor)
+
+        # Non-contiguous source and target go through row chunks and staging
+        remote_t = torch.zeros(96, 64).to(shared_devices["t4"].device()).t()
+        remote_t.copy_(cpu_tensor)
+        NumericalTestUtils.assert_tensors_close(remote_t.cpu(), cpu_tensor)
+        NumericalTestUtils.assert_tensors_close(
+            remote_tensor[10:50].cpu(), cpu_tensor[10:50]
+        )
+
+    def test_delta_upload_sends_changed_chunks(self, shared_devices, monkeypatch):
+        """Test that re-uploading a tensor only sends the chunks that changed."""
+        import mycelya_torch._tensor_utils as tensor_utils
+
+        monkeypatch.setattr(tensor_utils, "DELTA_CHUNK_BYTES", 4096)
+        machine_id = shared_devices["t4"].machine_id
+
+        cpu_tensor = torch.randn(64, 96)  # 6 chunks of 4096 bytes
+        remote_tensor = cpu_tensor.to(shared_devices["t4"].device())
+        remote_tensor.copy_(cpu_tensor)
+        # Deltas are only taken against uploads the server confirmed
+        remote_tensor.cpu()
+        shared_devices["t4"]._client._batch_pipeline.wait_idle()
+
+        uploaded = torch.mycelya.transfer_stats()[machine_id]["upload"]["raw_bytes"]
+        cpu_tensor[5] += 1.0  # touches only the first chunk
+        remote_tensor.copy_(cpu_tensor)
+        stats = torch.mycelya.transfer_stats()[machine_id]["upload"]
+        assert stats["raw_bytes"] - uploaded == 4096
+
+        NumericalTestUtils.assert_tensors_close(remote_tensor.cpu(), cpu_tensor)
+
+    def test_deduplicated_upload(self, shared_devices, tmp_path, monkeypatch):
+        """Test that loading a checkpoint again is served from the blob store."""
+        import json
+        import struct
+
+        import mycelya_torch
+        import mycelya_torch._tensor_utils as tensor_utils
+
+        monkeypatch.setattr(tensor_utils, "TRANSFER_CHUNK_BYTES", 4096)
+        monkeypatch.setattr(tensor_utils, "DELTA_CHUNK_BYTES", 4096)
+        monkeypatch.setattr(tensor_utils, "DEDUP_MIN_BYTES", 4096)
+        monkeypatch.setenv("MYCELYA_BLOB_DIR", str(tmp_path / "blobs"))
+        machine_id = shared_devices["t4"].machine_id
+
+        cpu_tensor = torch.randn(64, 96)
+        data = cpu_tensor.reshape(-1).view(torch.uint8).numpy().tobytes()
+        header = json.dumps(
+            {"w": {"dtype": "F32", "shape": [64, 96], "data_offsets": [0, len(data)]}}
+        ).encode()
+        path = tmp_path / "model.safetensors"
+        path.write_bytes(struct.pack("<Q", len(header)) + header + data)
+
+        # Plain uploads are never looked up in the blob store
+        before = torch.mycelya.transfer_stats()[machine_id]["dedup"]
+        cpu_tensor.to(shared_devices["t4"].device())
+        cpu_tensor.to(shared_devices["t4"].device())
+        assert torch.mycelya.transfer_stats()[machine_id]["dedup"] == before
+
+        first = mycelya_torch.load_safetensors(
+            str(path), shared_devices["t4"], dedup=True
+        )["w"]
+        second = mycelya_torch.load_safetensors(
+            str(path), shared_devices["t4"], dedup=True
+        )["w"]
+        dedup = torch.mycelya.transfer_stats()[machine_id]["dedup"]
+        assert dedup["misses"] == before["misses"] + 1
+        assert dedup["hits"] == before["hits"] + 1
+        assert dedup["bytes_saved"] == before["bytes_saved"] + len(data)
+
+        NumericalTestUtils.assert_tensors_close(first.cpu(), cpu_tensor)
+        NumericalTestUtils.assert_tensors_close(second.cpu(), cpu_tensor)
+
     def test_transfer_empty_tensors(self, shared_devices):
         """Test transfer of empty tensors."""
         empty_tensor = torch.empty(0, 2)
@@ -335,6 +647,77 @@ class TestTransferMemoryEfficiency:
             # Clear references
             del remote_tensor, back_to_cpu
 
+    def test_storage_cache_byte_budget(self, shared_devices):
+        """Test that the download cache evicts LRU storages to fit its budget."""
+        machine_id = shared_devices["t4"].machine_id
+        defaults = torch.mycelya.storage_cache_stats()[machine_id]
+
+        cpu_tensors = [torch.randn(32, 32) for _ in range(3)]  # 4096 bytes each
+        remote_tensors = [t.to(shared_devices["t4"].device()) for t in cpu_tensors]
+        torch.mycelya.set_storage_cache_limits(2 * 4096)
+        try:
+            evictions = defaults["cache_evictions"]
+            for remote_tensor in remote_tensors:
+                remote_tensor.cpu()
+            remote_tensors[2].cpu()
+
+            stats = torch.mycelya.storage_cache_stats()[machine_id]
+            assert stats["cache_bytes"] <= 2 * 4096
+            assert stats["cache_evictions"] > evictions
+            storage_id = remote_tensors[2].untyped_storage().data_ptr()
+            assert stats["entry_hits"][storage_id] == 1
+
+            torch.mycelya.set_storage_cache_limits(2 * 4096, max_entry_bytes=1024)
+            assert torch.mycelya.storage_cache_stats()[machine_id]["cache_size"] == 0
+            for remote_tensor, cpu_tensor in zip(remote_tensors, cpu_tensors):
+                NumericalTestUtils.assert_tensors_close(remote_tensor.cpu(), cpu_tensor)
+        finally:
+            torch.mycelya.set_storage_cache_limits(
+                defaults["max_bytes"], defaults["max_entry_bytes"]
+            )
+
+    def test_storage_cache_version_coherence(self, shared_devices):
+        """Test that cached downloads survive reads and go stale after writes."""
+        machine = shared_devices["t4"]
+        cpu_tensor = torch.randn(8, 8)
+        remote_tensor = cpu_tensor.to(machine.device())
+        storage_id = remote_tensor.untyped_storage().data_ptr()
+
+        remote_tensor.cpu()
+        version = machine._client.storage_version(storage_id)
+        (remote_tensor * 2).cpu()  # reads remote_tensor without writing it
+        assert machine._client.storage_version(storage_id) == version
+        remote_tensor.cpu()
+        hits = torch.mycelya.storage_cache_stats()[machine.machine_id]["entry_hits"]
+        assert hits[storage_id] == 1
+
+        stale = torch.mycelya.storage_cache_stats()[machine.machine_id]["cache_stale"]
+        remote_tensor.add_(1.0)
+        assert machine._client.storage_version(storage_id) > version
+        NumericalTestUtils.assert_tensors_close(remote_tensor.cpu(), cpu_tensor + 1.0)
+        stats = torch.mycelya.storage_cache_stats()[machine.machine_id]
+        assert stats["cache_stale"] == stale + 1
+
+    def test_read_after_inplace_op_without_outputs(self, shared_devices):
+        """Test that reads see writes of in-place ops that return nothing."""
+        device = shared_devices["t4"].device()
+        cpu_tensors = [torch.randn(8, 4), torch.randn(16)]
+        remote_tensors = [t.to(device) for t in cpu_tensors]
+        remote_tensors[0].cpu()  # cached before the write
+
+        torch._foreach_add_(remote_tensors, 1.0)
+        for remote_tensor, cpu_tensor in zip(remote_tensors, cpu_tensors):
+            NumericalTestUtils.assert_tensors_close(
+                remote_tensor.cpu(), cpu_tensor + 1.0
+            )
+
+        # Foreach optimizers update parameters the same way
+        param = torch.nn.Parameter(torch.randn(4, 4).to(device))
+        expected = param.detach().cpu()
+        param.grad = torch.ones(4, 4).to(device)
+        torch.optim.SGD([param], lr=0.5, foreach=True).step()
+        NumericalTestUtils.assert_tensors_close(param.detach().cpu(), expected - 0.5)
+
     def test_transfer_with_gradient_memory(self, shared_devices):
         """Test memory behavior of transfers with gradients."""
         base_tensor = torch.randn(5, 5, requires_grad=True)